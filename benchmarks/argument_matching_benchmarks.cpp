@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include <cstdlib>
+#include <string>
+
+#include "benchmark.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct Service {
+    virtual int handle(int id, int size, const std::string &tag) = 0;
+};
+
+/**
+ * A user defined matcher creator, so its matchers are only known at run time.
+ */
+struct IsTag : TypedMatcherCreator<std::string> {
+    struct Matcher : TypedMatcher<std::string> {
+        virtual bool matches(const std::string &actual) const override {
+            return actual == "x";
+        }
+
+        virtual std::string format() const override {
+            return "tag";
+        }
+    };
+
+    virtual TypedMatcher<std::string> *createMatcher() const override {
+        return new Matcher();
+    }
+};
+
+template<typename F>
+static void callMatchedMethod(bench::State &state, Mock<Service> &mock, F stubClause) {
+    // clauses are tried from the last registered one and the call is matched by the first one, so
+    // every clause is tried, and all but the first fail on their first argument.
+    for (int id = 0; id < 10; id++) {
+        stubClause(id);
+    }
+    Service &i = mock.get();
+    const std::string tag{"x"};
+    int sum = 0;
+    while (state.KeepRunning()) {
+        sum += i.handle(0, 4, tag);
+    }
+    if (sum == 0)
+        std::abort();
+}
+
+/**
+ * Cost of one call matched against 10 When(Method(mock, handle).Using(id, Gt(3), "x")) clauses.
+ */
+static void match_builtin_argument_matchers(bench::State &state) {
+    Mock<Service> mock(NoRecording);
+    callMatchedMethod(state, mock, [&](int id) {
+        When(Method(mock, handle).Using(id, Gt(3), "x")).AlwaysReturn(id + 1);
+    });
+}
+
+/**
+ * Same as match_builtin_argument_matchers, with a user defined matcher for the last argument.
+ */
+static void match_user_defined_argument_matchers(bench::State &state) {
+    Mock<Service> mock(NoRecording);
+    callMatchedMethod(state, mock, [&](int id) {
+        When(Method(mock, handle).Using(id, Gt(3), IsTag())).AlwaysReturn(id + 1);
+    });
+}
+
+BENCHMARK(match_builtin_argument_matchers);
+BENCHMARK(match_user_defined_argument_matchers);
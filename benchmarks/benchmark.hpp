@@ -0,0 +1,219 @@
+/*
+ * benchmark.hpp
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ *
+ * A minimal, dependency free micro benchmark runner.
+ * A benchmark is a function that receives a State and runs its measured code
+ * inside a "while (state.KeepRunning())" loop. Code before the loop is not measured.
+ * Each benchmark may be registered with a list of arguments, available through State::range().
+ * Results are printed as a table, or as CSV or JSON for tools that track them from release to release.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    class State {
+        typedef std::chrono::steady_clock Clock;
+
+        const long _range;
+        const size_t _maxIterations;
+        size_t _iterations;
+        Clock::time_point _start;
+        Clock::duration _elapsed;
+
+    public:
+        State(long range, size_t maxIterations) :
+                _range(range), _maxIterations(maxIterations), _iterations(0), _elapsed(0) {
+        }
+
+        bool KeepRunning() {
+            if (_iterations == 0) {
+                _start = Clock::now();
+            }
+            if (_iterations < _maxIterations) {
+                _iterations++;
+                return true;
+            }
+            _elapsed = Clock::now() - _start;
+            return false;
+        }
+
+        long range() const {
+            return _range;
+        }
+
+        size_t iterations() const {
+            return _maxIterations;
+        }
+
+        double elapsedSeconds() const {
+            return std::chrono::duration<double>(_elapsed).count();
+        }
+    };
+
+    typedef void (*Function)(State &);
+
+    struct Benchmark {
+        std::string name;
+        Function function;
+        std::vector<long> ranges;
+    };
+
+    inline std::vector<Benchmark> &benchmarks() {
+        static std::vector<Benchmark> all;
+        return all;
+    }
+
+    struct Registration {
+        Registration(const char *name, Function function, std::vector<long> ranges) {
+            benchmarks().push_back(Benchmark{name, function, ranges});
+        }
+    };
+
+    struct Result {
+        std::string name;
+        size_t iterations;
+        double nsPerIteration;
+    };
+
+    /**
+     * Grow the iteration count until a run takes at least minTime seconds.
+     */
+    inline Result measure(const std::string &name, Function function, long range, double minTime) {
+        size_t iterations = 1;
+        for (;;) {
+            State state(range, iterations);
+            function(state);
+            double elapsed = state.elapsedSeconds();
+            if (elapsed >= minTime || iterations >= 1000000000) {
+                return Result{name, iterations, elapsed * 1e9 / iterations};
+            }
+            size_t next = elapsed > 0 ? (size_t) (iterations * 1.4 * minTime / elapsed) : iterations * 10;
+            iterations = next > iterations * 10 ? iterations * 10 : (next > iterations ? next : iterations + 1);
+        }
+    }
+
+    enum class Format {
+        Console, Csv, Json
+    };
+
+    struct Options {
+        Options() : minTime(0.2), format(Format::Console) {
+        }
+
+        double minTime;
+        Format format;
+        std::string filter; // only run benchmarks whose name contains it
+    };
+
+    /**
+     * Prints each result as soon as it is measured, so a long run shows progress.
+     */
+    class Reporter {
+        const Format _format;
+        bool _first;
+
+    public:
+        explicit Reporter(Format format) : _format(format), _first(true) {
+        }
+
+        void header() {
+            switch (_format) {
+                case Format::Console:
+                    std::printf("%-50s %15s\n", "Benchmark", "ns/iteration");
+                    break;
+                case Format::Csv:
+                    std::printf("name,iterations,ns_per_iteration\n");
+                    break;
+                case Format::Json:
+                    std::printf("{\n  \"benchmarks\": [");
+                    break;
+            }
+        }
+
+        // names are C identifiers followed by "/<range>", so they need no quoting or escaping.
+        void report(const Result &result) {
+            switch (_format) {
+                case Format::Console:
+                    std::printf("%-50s %15.1f\n", result.name.c_str(), result.nsPerIteration);
+                    break;
+                case Format::Csv:
+                    std::printf("%s,%zu,%.1f\n", result.name.c_str(), result.iterations, result.nsPerIteration);
+                    break;
+                case Format::Json:
+                    std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"ns_per_iteration\": %.1f}",
+                                _first ? "" : ",", result.name.c_str(), result.iterations, result.nsPerIteration);
+                    break;
+            }
+            _first = false;
+            std::fflush(stdout);
+        }
+
+        void footer() {
+            if (_format == Format::Json)
+                std::printf("\n  ]\n}\n");
+        }
+    };
+
+    inline int runAll(const Options &options) {
+        Reporter reporter(options.format);
+        reporter.header();
+        for (const Benchmark &b : benchmarks()) {
+            for (long range : b.ranges) {
+                std::string name = b.name;
+                if (b.ranges.size() > 1 || range != 0) {
+                    name += "/" + std::to_string(range);
+                }
+                if (name.find(options.filter) == std::string::npos)
+                    continue;
+                reporter.report(measure(name, b.function, range, options.minTime));
+            }
+        }
+        reporter.footer();
+        return 0;
+    }
+
+    /**
+     * Accepts --format=console|csv|json, --filter=<text> and --min_time=<seconds>. A bare number is taken
+     * as the minimal time. Returns false on an unknown argument.
+     */
+    inline bool parseOptions(int argc, char *argv[], Options &options) {
+        for (int i = 1; i < argc; i++) {
+            const char *arg = argv[i];
+            if (std::strcmp(arg, "--format=console") == 0) {
+                options.format = Format::Console;
+            } else if (std::strcmp(arg, "--format=csv") == 0) {
+                options.format = Format::Csv;
+            } else if (std::strcmp(arg, "--format=json") == 0) {
+                options.format = Format::Json;
+            } else if (std::strncmp(arg, "--filter=", 9) == 0) {
+                options.filter = arg + 9;
+            } else if (std::strncmp(arg, "--min_time=", 11) == 0) {
+                options.minTime = std::atof(arg + 11);
+            } else if (std::atof(arg) > 0) {
+                options.minTime = std::atof(arg);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+#define BENCHMARK_CONCAT2(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT2(a, b)
+
+#define BENCHMARK(function) \
+    static bench::Registration BENCHMARK_CONCAT(benchmark_registration_, __LINE__)(#function, function, {0})
+
+#define BENCHMARK_WITH_RANGES(function, ...) \
+    static bench::Registration BENCHMARK_CONCAT(benchmark_registration_, __LINE__)(#function, function, {__VA_ARGS__})
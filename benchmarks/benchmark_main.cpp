@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include <cstdio>
+#include "benchmark.hpp"
+
+int main(int argc, char *argv[]) {
+    bench::Options options;
+    if (!bench::parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--format=console|csv|json] [--filter=<text>] [--min_time=<seconds>]\n",
+                     argv[0]);
+        return 2;
+    }
+    return bench::runAll(options);
+}
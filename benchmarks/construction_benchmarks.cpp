@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include "benchmark.hpp"
+#include "wide_interfaces.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+/**
+ * Cost of creating and destroying one mock, against the number of virtual methods of the mocked interface.
+ * Mocks created per second is the inverse of the reported time.
+ */
+template<typename C>
+static void createMocks(bench::State &state) {
+    while (state.KeepRunning()) {
+        Mock<C> mock;
+    }
+}
+
+static void create_mock(bench::State &state) {
+    switch (state.range()) {
+        case 5:
+            createMocks<Wide5>(state);
+            break;
+        case 50:
+            createMocks<Wide50>(state);
+            break;
+        default:
+            createMocks<Wide500>(state);
+            break;
+    }
+}
+
+/**
+ * Same, with one method stubbed.
+ */
+static void create_stubbed_mock(bench::State &state) {
+    switch (state.range()) {
+        case 5:
+            while (state.KeepRunning()) {
+                Mock<Wide5> mock;
+                Fake(Method(mock, m0));
+            }
+            break;
+        case 50:
+            while (state.KeepRunning()) {
+                Mock<Wide50> mock;
+                Fake(Method(mock, m00));
+            }
+            break;
+        default:
+            while (state.KeepRunning()) {
+                Mock<Wide500> mock;
+                Fake(Method(mock, m000));
+            }
+            break;
+    }
+}
+
+/**
+ * Same, with the stubbing shared from a template mock.
+ */
+static void create_mock_from_template(bench::State &state) {
+    switch (state.range()) {
+        case 5: {
+            Mock<Wide5> prototype;
+            Fake(Method(prototype, m0));
+            while (state.KeepRunning()) {
+                Mock<Wide5> mock(StubbedLike(prototype));
+            }
+            break;
+        }
+        case 50: {
+            Mock<Wide50> prototype;
+            Fake(Method(prototype, m00));
+            while (state.KeepRunning()) {
+                Mock<Wide50> mock(StubbedLike(prototype));
+            }
+            break;
+        }
+        default: {
+            Mock<Wide500> prototype;
+            Fake(Method(prototype, m000));
+            while (state.KeepRunning()) {
+                Mock<Wide500> mock(StubbedLike(prototype));
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * Cost of resetting a mock between test cases that stub one method and call it, against the number of
+ * virtual methods of the mocked interface.
+ */
+template<typename C, typename M>
+static void resetMocks(bench::State &state, Mock<C> &mock, M stubAndCall) {
+    while (state.KeepRunning()) {
+        stubAndCall();
+        mock.Reset();
+    }
+}
+
+static void reset_mock(bench::State &state) {
+    switch (state.range()) {
+        case 5: {
+            Mock<Wide5> mock;
+            resetMocks(state, mock, [&]() {
+                When(Method(mock, m0)).AlwaysReturn(1);
+                mock.get().m0(0);
+            });
+            break;
+        }
+        case 50: {
+            Mock<Wide50> mock;
+            resetMocks(state, mock, [&]() {
+                When(Method(mock, m00)).AlwaysReturn(1);
+                mock.get().m00(0);
+            });
+            break;
+        }
+        default: {
+            Mock<Wide500> mock;
+            resetMocks(state, mock, [&]() {
+                When(Method(mock, m000)).AlwaysReturn(1);
+                mock.get().m000(0);
+            });
+            break;
+        }
+    }
+}
+
+BENCHMARK_WITH_RANGES(create_mock, 5, 50, 500);
+BENCHMARK_WITH_RANGES(create_stubbed_mock, 5, 50, 500);
+BENCHMARK_WITH_RANGES(create_mock_from_template, 5, 50, 500);
+BENCHMARK_WITH_RANGES(reset_mock, 5, 50, 500);
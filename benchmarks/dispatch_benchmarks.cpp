@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include <cstdlib>
+
+#include "benchmark.hpp"
+#include "wide_interfaces.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+/**
+ * Cost of one call to a stubbed method, against the number of virtual methods of the mocked interface.
+ * The last method of the interface is stubbed, since it is the slowest one to find by a linear scan.
+ */
+template<typename C, typename F>
+static void callStubbedMethod(bench::State &state, Mock<C> &mock, F method) {
+    C &i = mock.get();
+    int sum = 0;
+    while (state.KeepRunning()) {
+        sum += (i.*method)(1);
+    }
+    if (sum == 0)
+        std::abort();
+}
+
+static void dispatch_stubbed_call(bench::State &state) {
+    switch (state.range()) {
+        case 5: {
+            Mock<Wide5> mock;
+            When(Method(mock, m4)).AlwaysReturn(1);
+            callStubbedMethod(state, mock, &Wide5::m4);
+            break;
+        }
+        case 50: {
+            Mock<Wide50> mock;
+            When(Method(mock, m49)).AlwaysReturn(1);
+            callStubbedMethod(state, mock, &Wide50::m49);
+            break;
+        }
+        default: {
+            Mock<Wide500> mock;
+            When(Method(mock, m499)).AlwaysReturn(1);
+            callStubbedMethod(state, mock, &Wide500::m499);
+            break;
+        }
+    }
+}
+
+BENCHMARK_WITH_RANGES(dispatch_stubbed_call, 5, 50, 500);
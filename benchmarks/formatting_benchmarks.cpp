@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "benchmark.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct Logger {
+    virtual void log(int level, const std::string &message) = 0;
+};
+
+/**
+ * Cost of failing VerifyNoOtherInvocations, which formats every unverified invocation into the message of
+ * the exception, against the number of unverified invocations.
+ */
+static void format_no_other_invocations_failure(bench::State &state) {
+    std::string message{"message"}; // recorded by reference, so it must outlive the mock
+    Mock<Logger> mock;
+    Fake(Method(mock, log));
+    Logger &i = mock.get();
+    for (long n = 0; n < state.range(); n++) {
+        i.log((int) n, message);
+    }
+    size_t length = 0;
+    while (state.KeepRunning()) {
+        try {
+            VerifyNoOtherInvocations(mock);
+        } catch (VerificationException &e) {
+            length += std::strlen(e.what());
+        }
+    }
+    if (length == 0)
+        std::abort();
+}
+
+/**
+ * Cost of a call that no clause matches, which formats the invocation into the message of the exception.
+ */
+static void format_unexpected_call(bench::State &state) {
+    Mock<Logger> mock;
+    When(Method(mock, log).Using(0, "expected")).Return();
+    Logger &i = mock.get();
+    size_t length = 0;
+    while (state.KeepRunning()) {
+        try {
+            i.log(1, "unexpected");
+        } catch (UnexpectedMethodCallException &e) {
+            length += e.what().size();
+        }
+    }
+    if (length == 0)
+        std::abort();
+}
+
+BENCHMARK_WITH_RANGES(format_no_other_invocations_failure, 1, 100, 1000);
+BENCHMARK(format_unexpected_call);
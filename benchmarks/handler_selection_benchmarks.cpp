@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include <cstdlib>
+
+#include "benchmark.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct Lookup {
+    virtual int lookup(int key) = 0;
+};
+
+/**
+ * Cost of one call to a method stubbed by N When(...).Using(key) clauses.
+ * The call matches the first registered clause, the last one found by a scan of the clauses.
+ */
+static void dispatch_with_many_clauses(bench::State &state) {
+    Mock<Lookup> mock;
+    for (int key = 0; key < state.range(); key++) {
+        When(Method(mock, lookup).Using(key)).AlwaysReturn(key + 1);
+    }
+    Lookup &i = mock.get();
+    int sum = 0;
+    while (state.KeepRunning()) {
+        sum += i.lookup(0);
+    }
+    if (sum == 0)
+        std::abort();
+}
+
+BENCHMARK_WITH_RANGES(dispatch_with_many_clauses, 1, 10, 100, 1000);
+
+/**
+ * Same as dispatch_with_many_clauses, with a clause for any key registered before the others and a
+ * clause for a range of keys registered after them.
+ */
+static void dispatch_with_many_clauses_and_wildcards(bench::State &state) {
+    Mock<Lookup> mock;
+    When(Method(mock, lookup)).AlwaysReturn(-1);
+    for (int key = 0; key < state.range(); key++) {
+        When(Method(mock, lookup).Using(key)).AlwaysReturn(key + 1);
+    }
+    When(Method(mock, lookup).Using(Gt((int) state.range()))).AlwaysReturn(0);
+    Lookup &i = mock.get();
+    int sum = 0;
+    while (state.KeepRunning()) {
+        sum += i.lookup(0);
+    }
+    if (sum == 0)
+        std::abort();
+}
+
+BENCHMARK_WITH_RANGES(dispatch_with_many_clauses_and_wildcards, 1, 10, 100, 1000);
@@ -0,0 +1,10 @@
+CPP_SRCS += \
+	argument_matching_benchmarks.cpp \
+	benchmark_main.cpp \
+	construction_benchmarks.cpp \
+	dispatch_benchmarks.cpp \
+	formatting_benchmarks.cpp \
+	handler_selection_benchmarks.cpp \
+	static_mock_benchmarks.cpp \
+	stubbing_benchmarks.cpp \
+	verification_benchmarks.cpp
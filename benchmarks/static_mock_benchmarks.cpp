@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include <cstdlib>
+
+#include "benchmark.hpp"
+#include "wide_interfaces.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+/**
+ * The static mock counterparts of dispatch_stubbed_call and create_stubbed_mock: the same interfaces, mocked by
+ * a subclass generated at compile time rather than by a patched virtual table.
+ */
+
+#define WIDE_STATIC_METHOD(name) FAKEIT_STATIC_METHOD1(name, int(int))
+
+FAKEIT_STATIC_MOCK(StaticWide5, Wide5, WIDE_5(WIDE_STATIC_METHOD, m));
+
+FAKEIT_STATIC_MOCK(StaticWide50, Wide50, WIDE_50(WIDE_STATIC_METHOD, m));
+
+FAKEIT_STATIC_MOCK(StaticWide500, Wide500, WIDE_500(WIDE_STATIC_METHOD, m));
+
+template<typename C, typename F>
+static void callStubbedMethod(bench::State &state, StaticMock<C> &mock, F method) {
+    C &i = mock.get();
+    int sum = 0;
+    while (state.KeepRunning()) {
+        sum += (i.*method)(1);
+    }
+    if (sum == 0)
+        std::abort();
+}
+
+static void static_dispatch_stubbed_call(bench::State &state) {
+    switch (state.range()) {
+        case 5: {
+            StaticWide5 mock;
+            When(Method(mock, m4)).AlwaysReturn(1);
+            callStubbedMethod(state, mock, &Wide5::m4);
+            break;
+        }
+        case 50: {
+            StaticWide50 mock;
+            When(Method(mock, m49)).AlwaysReturn(1);
+            callStubbedMethod(state, mock, &Wide50::m49);
+            break;
+        }
+        default: {
+            StaticWide500 mock;
+            When(Method(mock, m499)).AlwaysReturn(1);
+            callStubbedMethod(state, mock, &Wide500::m499);
+            break;
+        }
+    }
+}
+
+/**
+ * A static mock has a body for each of its methods from the start, so its creation grows with their number.
+ */
+static void create_static_stubbed_mock(bench::State &state) {
+    switch (state.range()) {
+        case 5:
+            while (state.KeepRunning()) {
+                StaticWide5 mock;
+                Fake(Method(mock, m0));
+            }
+            break;
+        case 50:
+            while (state.KeepRunning()) {
+                StaticWide50 mock;
+                Fake(Method(mock, m00));
+            }
+            break;
+        default:
+            while (state.KeepRunning()) {
+                StaticWide500 mock;
+                Fake(Method(mock, m000));
+            }
+            break;
+    }
+}
+
+BENCHMARK_WITH_RANGES(static_dispatch_stubbed_call, 5, 50, 500);
+BENCHMARK_WITH_RANGES(create_static_stubbed_mock, 5, 50, 500);
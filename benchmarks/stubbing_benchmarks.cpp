@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include "benchmark.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct Calculator {
+    virtual int add(int, int) = 0;
+};
+
+/**
+ * Cost of When(Method(mock, add).Using(n, n)).Return(n), against the number of clauses stubbed on the method
+ * before the mock is reset. One iteration stubs all the clauses.
+ */
+static void stub_return(bench::State &state) {
+    Mock<Calculator> mock;
+    int clauses = (int) state.range();
+    while (state.KeepRunning()) {
+        for (int n = 0; n < clauses; n++) {
+            When(Method(mock, add).Using(n, n)).Return(n);
+        }
+        mock.Reset();
+    }
+}
+
+/**
+ * Same, with a sequence of return values stubbed by a single clause.
+ */
+static void stub_return_sequence(bench::State &state) {
+    Mock<Calculator> mock;
+    int values = (int) state.range();
+    while (state.KeepRunning()) {
+        {
+            auto method = Method(mock, add);
+            auto &&progress = When(method);
+            for (int n = 0; n < values; n++) {
+                progress.Return(n);
+            }
+        }
+        mock.Reset();
+    }
+}
+
+BENCHMARK_WITH_RANGES(stub_return, 1, 10, 100);
+BENCHMARK_WITH_RANGES(stub_return_sequence, 1, 10, 100);
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#include "benchmark.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct Steps {
+    virtual void step() = 0;
+
+    virtual void last() = 0;
+};
+
+/**
+ * Verify(Method(mock, step) * (length - 1) + Method(mock, last)).Never() over a history of calls to step() only.
+ * Every position of the history matches the pattern up to its last element, which is the worst case of a
+ * sliding window search.
+ */
+static void verifyNearMisses(bench::State &state, int historySize, int patternLength) {
+    Mock<Steps> mock;
+    Fake(Method(mock, step), Method(mock, last));
+    Steps &i = mock.get();
+    for (int n = 0; n < historySize; n++) {
+        i.step();
+    }
+    while (state.KeepRunning()) {
+        Verify(Method(mock, step) * (patternLength - 1) + Method(mock, last)).Never();
+    }
+}
+
+/**
+ * Scales the recorded history with a pattern of 10 invocations.
+ */
+static void verify_sequence_by_history_size(bench::State &state) {
+    verifyNearMisses(state, (int) state.range(), 10);
+}
+
+/**
+ * Scales the pattern length against a history of 10000 invocations.
+ */
+static void verify_sequence_by_pattern_length(bench::State &state) {
+    verifyNearMisses(state, 10000, (int) state.range());
+}
+
+/**
+ * Verify(Method(mock, step)).Exactly(n) over a history of n calls.
+ */
+static void verify_recorded_calls(bench::State &state) {
+    Mock<Steps> mock;
+    Fake(Method(mock, step));
+    Steps &i = mock.get();
+    for (long n = 0; n < state.range(); n++) {
+        i.step();
+    }
+    while (state.KeepRunning()) {
+        Verify(Method(mock, step)).Exactly((int) state.range());
+    }
+}
+
+/**
+ * VerifyNoOtherInvocations on a mock whose whole history was already verified.
+ */
+static void verify_no_other_invocations_when_all_verified(bench::State &state) {
+    Mock<Steps> mock;
+    Fake(Method(mock, step));
+    Steps &i = mock.get();
+    for (long n = 0; n < state.range(); n++) {
+        i.step();
+    }
+    Verify(Method(mock, step)).Exactly((int) state.range());
+    while (state.KeepRunning()) {
+        VerifyNoOtherInvocations(mock);
+    }
+}
+
+/**
+ * Converting a failing verification to bool, as when polling for a call that wasn't made yet.
+ */
+static void check_failing_verification(bench::State &state) {
+    Mock<Steps> mock;
+    Fake(Method(mock, step), Method(mock, last));
+    Steps &i = mock.get();
+    for (long n = 0; n < state.range(); n++) {
+        i.step();
+    }
+    while (state.KeepRunning()) {
+        bool passed = Verify(Method(mock, last));
+        (void) passed;
+    }
+}
+
+BENCHMARK_WITH_RANGES(verify_sequence_by_history_size, 1000, 10000, 100000);
+BENCHMARK_WITH_RANGES(verify_sequence_by_pattern_length, 10, 100, 1000);
+BENCHMARK_WITH_RANGES(verify_recorded_calls, 10, 1000, 100000);
+BENCHMARK_WITH_RANGES(verify_no_other_invocations_when_all_verified, 1000, 10000, 100000);
+BENCHMARK_WITH_RANGES(check_failing_verification, 1, 100, 10000);
@@ -0,0 +1,30 @@
+/*
+ * wide_interfaces.hpp
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ *
+ * Interfaces with 5, 50 and 500 virtual methods, used to show how a code path scales with the vtable size.
+ * Methods are named m0..m4, m00..m49 and m000..m499.
+ */
+#pragma once
+
+#define WIDE_METHOD(name) virtual int name(int) = 0;
+
+#define WIDE_5(M, p) M(p##0) M(p##1) M(p##2) M(p##3) M(p##4)
+#define WIDE_10(M, p) WIDE_5(M, p) M(p##5) M(p##6) M(p##7) M(p##8) M(p##9)
+#define WIDE_50(M, p) WIDE_10(M, p##0) WIDE_10(M, p##1) WIDE_10(M, p##2) WIDE_10(M, p##3) WIDE_10(M, p##4)
+#define WIDE_100(M, p) WIDE_50(M, p) WIDE_10(M, p##5) WIDE_10(M, p##6) WIDE_10(M, p##7) WIDE_10(M, p##8) WIDE_10(M, p##9)
+#define WIDE_500(M, p) WIDE_100(M, p##0) WIDE_100(M, p##1) WIDE_100(M, p##2) WIDE_100(M, p##3) WIDE_100(M, p##4)
+
+struct Wide5 {
+    WIDE_5(WIDE_METHOD, m)
+};
+
+struct Wide50 {
+    WIDE_50(WIDE_METHOD, m)
+};
+
+struct Wide500 {
+    WIDE_500(WIDE_METHOD, m)
+};
@@ -1,5 +1,9 @@
 CPP_SRCS += \
 	argument_matching_tests.cpp \
+	arguments_capture_tests.cpp \
+	async_event_dispatch_tests.cpp \
+	bounded_history_tests.cpp \
+	call_statistics_tests.cpp \
 	cpp14_tests.cpp \
 	custom_event_formatting_tests.cpp \
 	custom_testing_framework_tests.cpp \
@@ -10,16 +14,21 @@ CPP_SRCS += \
 	functional.cpp \
 	gcc_stubbing_multiple_values_tests.cpp \
 	gcc_type_info_tests.cpp \
+	invocation_trace_tests.cpp \
 	miscellaneous_tests.cpp \
 	msc_stubbing_multiple_values_tests.cpp \
 	msc_type_info_tests.cpp \
+	no_recording_tests.cpp \
 	referece_types_tests.cpp \
 	remove_const_volatile_tests.cpp \
 	rvalue_arguments_tests.cpp \
 	sequence_verification_tests.cpp \
 	spying_tests.cpp \
+	static_mock_tests.cpp \
 	streaming_tests.cpp \
+	stubbing_template_tests.cpp \
 	stubbing_tests.cpp \
+	thread_safe_tests.cpp \
 	tpunit++main.cpp \
 	type_info_tests.cpp \
 	verification_errors_tests.cpp \
@@ -12,6 +12,8 @@
 #include <atomic>
 #include <tuple>
 #include <type_traits>
+#include <limits>
+#include <utility>
 
 #include "mockutils/DefaultValue.hpp"
 #include "mockutils/Destructible.hpp"
@@ -23,9 +25,17 @@ namespace fakeit {
 
     template<typename R, typename ... arglist>
     struct Action : Destructible {
+        static const size_t UNLIMITED = std::numeric_limits<size_t>::max();
+
         virtual R invoke(const ArgumentsTuple<arglist...> &) = 0;
 
-        virtual bool isDone() = 0;
+        /**
+         * The number of invocations this action handles before the next action of its sequence takes over.
+         * UNLIMITED if it handles all the remaining invocations.
+         */
+        virtual size_t getQuantity() const {
+            return UNLIMITED;
+        }
     };
 
     template<typename R, typename ... arglist>
@@ -33,25 +43,24 @@ namespace fakeit {
         virtual ~Repeat() = default;
 
         Repeat(std::function<R(typename fakeit::test_arg<arglist>::type...)> func) :
-                f(func), times(1) {
+                f(std::move(func)), times(1) {
         }
 
         Repeat(std::function<R(typename fakeit::test_arg<arglist>::type...)> func, long t) :
-                f(func), times(t) {
+                f(std::move(func)), times(t) {
         }
 
         virtual R invoke(const ArgumentsTuple<arglist...> & args) override {
-            times--;
             return TupleDispatcher::invoke<R, arglist...>(f, args);
         }
 
-        virtual bool isDone() override {
-            return times == 0;
+        virtual size_t getQuantity() const override {
+            return times > 0 ? (size_t) times : 0;
         }
 
     private:
         std::function<R(typename fakeit::test_arg<arglist>::type...)> f;
-        long times;
+        const long times;
     };
 
     template<typename R, typename ... arglist>
@@ -60,19 +69,87 @@ namespace fakeit {
         virtual ~RepeatForever() = default;
 
         RepeatForever(std::function<R(typename fakeit::test_arg<arglist>::type...)> func) :
-                f(func) {
+                f(std::move(func)) {
         }
 
         virtual R invoke(const ArgumentsTuple<arglist...> & args) override {
             return TupleDispatcher::invoke<R, arglist...>(f, args);
         }
 
-        virtual bool isDone() override {
-            return false;
+    private:
+        std::function<R(typename fakeit::test_arg<arglist>::type...)> f;
+    };
+
+    /**
+     * The value returned by ReturnValue and ReturnValueForever. A reference is kept as a pointer to the referred object.
+     */
+    template<typename R>
+    struct ReturnedValue {
+        ReturnedValue(const R &r) :
+                _value(r) {
+        }
+
+        R get() const {
+            return _value;
         }
 
     private:
-        std::function<R(typename fakeit::test_arg<arglist>::type...)> f;
+        const R _value;
+    };
+
+    template<typename R>
+    struct ReturnedValue<R &> {
+        ReturnedValue(R &r) :
+                _value(&r) {
+        }
+
+        R &get() const {
+            return *_value;
+        }
+
+    private:
+        R *_value;
+    };
+
+    template<typename R, typename ... arglist>
+    struct ReturnValue : public Action<R, arglist...> {
+        virtual ~ReturnValue() = default;
+
+        ReturnValue(const R &r) :
+                _value(r), times(1) {
+        }
+
+        ReturnValue(const R &r, long t) :
+                _value(r), times(t) {
+        }
+
+        virtual R invoke(const ArgumentsTuple<arglist...> &) override {
+            return _value.get();
+        }
+
+        virtual size_t getQuantity() const override {
+            return times > 0 ? (size_t) times : 0;
+        }
+
+    private:
+        ReturnedValue<R> _value;
+        const long times;
+    };
+
+    template<typename R, typename ... arglist>
+    struct ReturnValueForever : public Action<R, arglist...> {
+        virtual ~ReturnValueForever() = default;
+
+        ReturnValueForever(const R &r) :
+                _value(r) {
+        }
+
+        virtual R invoke(const ArgumentsTuple<arglist...> &) override {
+            return _value.get();
+        }
+
+    private:
+        ReturnedValue<R> _value;
     };
 
     template<typename R, typename ... arglist>
@@ -82,16 +159,12 @@ namespace fakeit {
         virtual R invoke(const ArgumentsTuple<arglist...> &) override {
             return DefaultValue<R>::value();
         }
-
-        virtual bool isDone() override {
-            return false;
-        }
     };
 
     template<typename R, typename ... arglist>
     struct ReturnDelegateValue : public Action<R, arglist...> {
 
-        ReturnDelegateValue(std::function<R(const typename fakeit::test_arg<arglist>::type...)> delegate) : _delegate(delegate) { }
+        ReturnDelegateValue(std::function<R(const typename fakeit::test_arg<arglist>::type...)> delegate) : _delegate(std::move(delegate)) { }
 
         virtual ~ReturnDelegateValue() = default;
 
@@ -99,10 +172,6 @@ namespace fakeit {
             return TupleDispatcher::invoke<R, arglist...>(_delegate, args);
         }
 
-        virtual bool isDone() override {
-            return false;
-        }
-
     private:
         std::function<R(const typename fakeit::test_arg<arglist>::type...)> _delegate;
     };
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <atomic>
 
 #include "fakeit/DomainObjects.hpp"
 #include "fakeit/ActualInvocation.hpp"
@@ -37,21 +39,70 @@ namespace fakeit {
             append(action);
         }
 
+        /**
+         * The steps don't change while the mock is called. Each call takes the next call number and runs
+         * the step whose range of call numbers holds it, so every scripted action runs exactly as many
+         * times as stubbed, even when several threads call the method at once.
+         */
         virtual R handleMethodInvocation(ArgumentsTuple<arglist...> & args) override
         {
-            std::shared_ptr<Destructible> destructablePtr = _recordedActions.front();
-            Destructible &destructable = *destructablePtr;
-            Action<R, arglist...> &action = dynamic_cast<Action<R, arglist...> &>(destructable);
-            std::function<void()> finallyClause = [&]() -> void {
-                if (action.isDone())
-                    _recordedActions.erase(_recordedActions.begin());
-            };
-            Finally onExit(finallyClause);
-            return action.invoke(args);
+            return handle(args, _progress);
+        }
+
+        /**
+         * The steps are shared with the fork, which counts the calls it handles from the progress made so far.
+         */
+        virtual ActualInvocationHandler<R, arglist...> *forkProgress() override {
+            if (_steps[0].end == UNLIMITED)
+                return nullptr;
+            return new Fork(*this);
         }
 
     private:
 
+        struct Progress {
+            Progress() : calls{0}, current{0} {
+            }
+
+            Progress(const Progress &other) :
+                    calls{other.calls.load(std::memory_order_relaxed)},
+                    current{other.current.load(std::memory_order_relaxed)} {
+            }
+
+            std::atomic<size_t> calls; // the calls that were counted so far
+            std::atomic<size_t> current; // no call is handled by a step before this one anymore
+        };
+
+        struct Fork : ActualInvocationHandler<R, arglist...> {
+            explicit Fork(ActionSequence &sequence) : _sequence(sequence), _progress(sequence._progress) {
+            }
+
+            virtual R handleMethodInvocation(ArgumentsTuple<arglist...> & args) override {
+                return _sequence.handle(args, _progress);
+            }
+
+        private:
+            ActionSequence &_sequence;
+            Progress _progress;
+        };
+
+        R handle(ArgumentsTuple<arglist...> & args, Progress &progress) {
+            size_t current = progress.current.load(std::memory_order_relaxed);
+            if (_steps[current].end != UNLIMITED) {
+                size_t call = progress.calls.fetch_add(1, std::memory_order_relaxed);
+                while (_steps[current].end <= call)
+                    current++;
+                size_t seen = progress.current.load(std::memory_order_relaxed);
+                while (seen < current &&
+                       !progress.current.compare_exchange_weak(seen, current, std::memory_order_relaxed)) {
+                }
+            }
+            // once an unlimited step is reached it handles all the remaining calls, so they are not counted.
+            return _steps[current].action->invoke(args);
+        }
+
+        static const size_t UNLIMITED = Action<R, arglist...>::UNLIMITED;
+
         struct NoMoreRecordedAction : Action<R, arglist...> {
 
 //            virtual ~NoMoreRecordedAction() override = default;
@@ -63,24 +114,32 @@ namespace fakeit {
             virtual R invoke(const ArgumentsTuple<arglist...> &) override {
                 throw NoMoreRecordedActionException();
             }
+        };
 
-            virtual bool isDone() override {
-                return false;
-            }
+        /**
+         * An action and the number of calls handled by it and all the steps before it.
+         */
+        struct Step {
+            std::unique_ptr<Action<R, arglist...>> action;
+            size_t end;
         };
 
         void append(Action<R, arglist...> *action) {
-            std::shared_ptr<Destructible> destructable{action};
-            _recordedActions.insert(_recordedActions.end() - 1, destructable);
+            size_t begin = _steps.size() > 1 ? _steps[_steps.size() - 2].end : 0;
+            size_t quantity = action->getQuantity();
+            size_t end = (begin == UNLIMITED || quantity == UNLIMITED) ? UNLIMITED : begin + quantity;
+            _steps.insert(_steps.end() - 1, Step{std::unique_ptr<Action<R, arglist...>>{action}, end});
         }
 
         void clear() {
-            _recordedActions.clear();
-            auto actionPtr = std::shared_ptr<Destructible> {new NoMoreRecordedAction()};
-            _recordedActions.push_back(actionPtr);
+            _progress.calls = 0;
+            _progress.current = 0;
+            _steps.clear();
+            _steps.push_back(Step{std::unique_ptr<Action<R, arglist...>>{new NoMoreRecordedAction()}, UNLIMITED});
         }
 
-        std::vector<std::shared_ptr<Destructible>> _recordedActions;
+        std::vector<Step> _steps; // the last step is always a NoMoreRecordedAction
+        Progress _progress;
     };
 
 }
@@ -14,6 +14,9 @@
 #include <string>
 #include <iosfwd>
 #include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "mockutils/type_utils.hpp"
 
 
@@ -48,16 +51,79 @@ namespace fakeit {
             virtual bool matches(ActualInvocation<arglist...> &actualInvocation) = 0;
 
             virtual std::string format() const = 0;
+
+            /**
+             * For a matcher that only matches arguments equal to fixed values: the TupleHash of these values.
+             * Returns false for any other matcher.
+             */
+            virtual bool getExpectedArgumentsHash(size_t &) const {
+                return false;
+            }
+        };
+
+        struct NoArguments {
         };
 
+        /**
+         * Parameters passed by value are moved in: the mocked method owns them and does not use them again.
+         */
         ActualInvocation(unsigned int ordinal, MethodInfo &method, const typename fakeit::production_arg<arglist>::type... args) :
-            Invocation(ordinal, method), _matcher{ nullptr }
-            , actualArguments{ std::forward<const typename fakeit::production_arg<arglist>::type>(args)... }
+            Invocation(ordinal, method), _matcher{ nullptr }, _capture(ArgumentsCapture::ByValue), _fingerprint(0)
         {
+            new(&_arguments) Arguments{ std::forward<arglist>(args)... };
         }
 
+        /**
+         * An invocation whose arguments are already released, as releaseArguments(capture, fingerprint) leaves it.
+         * Used for invocations read back from a trace that did not keep the arguments.
+         */
+        ActualInvocation(unsigned int ordinal, MethodInfo &method, ArgumentsCapture capture, size_t fingerprint,
+                         NoArguments) :
+            Invocation(ordinal, method), _matcher{ nullptr }, _capture(capture), _fingerprint(fingerprint)
+        {
+        }
+
+        virtual ~ActualInvocation() override {
+            if (hasArguments())
+                getActualArguments().~Arguments();
+        }
+
+        ActualInvocation(const ActualInvocation &) = delete;
+
+        ActualInvocation &operator=(const ActualInvocation &) = delete;
+
+        /**
+         * Only valid while hasArguments().
+         */
         ArgumentsTuple<arglist...> & getActualArguments() {
-            return actualArguments;
+            return *reinterpret_cast<Arguments *>(&_arguments);
+        }
+
+        const ArgumentsTuple<arglist...> & getActualArguments() const {
+            return *reinterpret_cast<const Arguments *>(&_arguments);
+        }
+
+        bool hasArguments() const {
+            return _capture == ArgumentsCapture::ByValue;
+        }
+
+        /**
+         * The fingerprint kept by releaseArguments(ArgumentsCapture::ByFingerprint, ...), if any.
+         */
+        bool getFingerprint(size_t &fingerprint) const {
+            fingerprint = _fingerprint;
+            return _capture == ArgumentsCapture::ByFingerprint;
+        }
+
+        /**
+         * Destroy the arguments once the call is over, keeping only the given fingerprint if capture is ByFingerprint.
+         */
+        void releaseArguments(ArgumentsCapture capture, size_t fingerprint) {
+            if (!hasArguments() || capture == ArgumentsCapture::ByValue)
+                return;
+            getActualArguments().~Arguments();
+            _capture = capture;
+            _fingerprint = fingerprint;
         }
 
         /**
@@ -73,20 +139,33 @@ namespace fakeit {
 
         virtual std::string format() const override {
             std::ostringstream out;
-            out << getMethod().name();
-            print(out, actualArguments);
+            format(out);
             return out.str();
         }
 
+        virtual void format(std::ostream &out) const override {
+            getMethod().formatName(out);
+            if (hasArguments() || sizeof...(arglist) == 0) {
+                print(out, getActualArguments());
+            } else if (_capture == ArgumentsCapture::ByFingerprint) {
+                out << "(<fingerprint " << std::hex << _fingerprint << ">)";
+            } else {
+                out << "(<not captured>)";
+            }
+        }
+
     private:
+        typedef ArgumentsTuple<arglist...> Arguments;
 
         Matcher *_matcher;
-        ArgumentsTuple<arglist...> actualArguments;
+        typename std::aligned_storage<sizeof(Arguments), std::alignment_of<Arguments>::value>::type _arguments;
+        ArgumentsCapture _capture;
+        size_t _fingerprint;
     };
 
     template<typename ... arglist>
     std::ostream &operator<<(std::ostream &strm, const ActualInvocation<arglist...> &ai) {
-        strm << ai.format();
+        ai.format(strm);
         return strm;
     }
 
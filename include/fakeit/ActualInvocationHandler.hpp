@@ -15,6 +15,14 @@ namespace fakeit {
     template<typename R, typename ... arglist>
     struct ActualInvocationHandler : Destructible {
         virtual R handleMethodInvocation(ArgumentsTuple<arglist...> & args) = 0;
+
+        /**
+         * A handler that handles calls like this one but keeps its own progress from now on, for another mock
+         * that shares it. Null if every call is handled the same way, so there is no progress to keep.
+         */
+        virtual ActualInvocationHandler<R, arglist...> *forkProgress() {
+            return nullptr;
+        }
     };
 
 }
@@ -3,13 +3,58 @@
 //
 
 #include <unordered_set>
+#include <vector>
+#include <algorithm>
 #include "fakeit/Invocation.hpp"
 
 namespace fakeit {
 
+    /**
+     * Runs of invocations, each run in invocation order.
+     * The same invocation may appear in more than one run.
+     */
+    typedef std::vector<std::vector<fakeit::Invocation *>> InvocationRuns;
+
     struct ActualInvocationsSource {
         virtual void getActualInvocations(std::unordered_set<fakeit::Invocation *> &into) const = 0;
 
+        /**
+         * Append the actual invocations as runs in invocation order, without building a set.
+         * The default sorts the result of getActualInvocations into a single run.
+         */
+        virtual void getActualInvocationRuns(InvocationRuns &into) const {
+            std::unordered_set<fakeit::Invocation *> invocations;
+            getActualInvocations(invocations);
+            into.emplace_back(invocations.begin(), invocations.end());
+            std::sort(into.back().begin(), into.back().end(), [](Invocation *a, Invocation *b) {
+                return a->getOrdinal() < b->getOrdinal();
+            });
+        }
+
+        /**
+         * True if invocations were dropped from a bounded history, so getActualInvocations returns
+         * only some of them.
+         */
+        virtual bool hasDroppedInvocations() const {
+            return false;
+        }
+
+        /**
+         * True if some of the dropped invocations were not verified, by a count verification that covered
+         * them or before they were dropped.
+         */
+        virtual bool hasDroppedUnverifiedInvocations() const {
+            return hasDroppedInvocations();
+        }
+
+        /**
+         * False only if all the actual invocations are known to be verified, which lets
+         * VerifyNoOtherInvocations skip collecting them.
+         */
+        virtual bool mayHaveUnverifiedInvocations() const {
+            return true;
+        }
+
         virtual ~ActualInvocationsSource() NO_THROWS { };
     };
 
@@ -23,6 +68,22 @@ namespace fakeit {
             _inner->getActualInvocations(into);
         }
 
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            _inner->getActualInvocationRuns(into);
+        }
+
+        bool hasDroppedInvocations() const override {
+            return _inner->hasDroppedInvocations();
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            return _inner->hasDroppedUnverifiedInvocations();
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            return _inner->mayHaveUnverifiedInvocations();
+        }
+
     private:
         std::shared_ptr<ActualInvocationsSource> _inner;
     };
@@ -42,6 +103,29 @@ namespace fakeit {
             }
         }
 
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            size_t first = into.size();
+            _decorated.getActualInvocationRuns(into);
+            for (size_t i = first; i < into.size(); i++) {
+                std::vector<fakeit::Invocation *> &run = into[i];
+                run.erase(std::remove_if(run.begin(), run.end(), [](fakeit::Invocation *invocation) {
+                    return invocation->isVerified();
+                }), run.end());
+            }
+        }
+
+        bool hasDroppedInvocations() const override {
+            return _decorated.hasDroppedInvocations();
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            return _decorated.hasDroppedUnverifiedInvocations();
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            return _decorated.mayHaveUnverifiedInvocations();
+        }
+
     private:
         InvocationsSourceProxy _decorated;
     };
@@ -59,6 +143,43 @@ namespace fakeit {
             filter(tmp, into);
         }
 
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            size_t first = into.size();
+            for (ActualInvocationsSource *source : _sources) {
+                source->getActualInvocationRuns(into);
+            }
+            for (size_t i = first; i < into.size(); i++) {
+                std::vector<fakeit::Invocation *> &run = into[i];
+                run.erase(std::remove_if(run.begin(), run.end(), [this](fakeit::Invocation *invocation) {
+                    return !shouldInclude(invocation);
+                }), run.end());
+            }
+        }
+
+        bool hasDroppedInvocations() const override {
+            for (ActualInvocationsSource *source : _sources) {
+                if (source->hasDroppedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            for (ActualInvocationsSource *source : _sources) {
+                if (source->hasDroppedUnverifiedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            for (ActualInvocationsSource *source : _sources) {
+                if (source->mayHaveUnverifiedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
     protected:
         bool shouldInclude(fakeit::Invocation *) const {
             return true;
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mockutils/BoundedQueue.hpp"
+#include "mockutils/Macros.hpp"
+#include "fakeit/EventHandler.hpp"
+
+namespace fakeit {
+
+    /**
+     * An invocation frozen at the time of the call: its method name and its formatted arguments.
+     * It refers to nothing of the mock, so it can be handled after the call returned and the mock is gone.
+     */
+    class InvocationSnapshot : public Invocation {
+        std::string _text;
+
+    public:
+        InvocationSnapshot(const Invocation &invocation, MethodInfo &method) :
+                Invocation(invocation.getOrdinal(), method), _text(invocation.format()) {
+        }
+
+        std::string format() const override {
+            return _text;
+        }
+
+        void format(std::ostream &out) const override {
+            out << _text;
+        }
+    };
+
+    /**
+     * Hands the unexpected call events of a context to its listeners on a background thread, so a slow
+     * listener doesn't slow down the mocked call that raised the event.
+     * Events are passed through a bounded lock free queue. A caller that finds it full waits for the
+     * dispatcher to make room: events are delayed, never lost. flush() waits until every event posted so far
+     * was handled and rethrows the first exception a listener threw since the last flush.
+     * Listeners are called on the dispatcher thread only, one event at a time, in the order of the posts.
+     * Each event goes to the listeners of the context at the time it was posted, so listeners can be added
+     * and cleared while the dispatcher runs.
+     */
+    class AsyncEventDispatcher {
+
+        struct PostedEvent {
+            PostedEvent(const UnexpectedMethodCallEvent &e, const std::vector<EventHandler *> &listeners) :
+                    listeners(listeners),
+                    method(e.getInvocation().getMethod()),
+                    invocation(e.getInvocation(), method),
+                    event(e.getUnexpectedType(), invocation) {
+                method.setUnverifiedInvocationsCounter(nullptr);
+            }
+
+            std::vector<EventHandler *> listeners;
+            MethodInfo method;
+            InvocationSnapshot invocation;
+            UnexpectedMethodCallEvent event;
+        };
+
+        BoundedQueue<PostedEvent *> _queue;
+        std::atomic<unsigned long long> _posted;
+        std::atomic<unsigned long long> _handled;
+        std::atomic<bool> _sleeping;
+        std::atomic<int> _flushing;
+        std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        std::condition_variable _progress;
+        bool _stopping;
+        std::exception_ptr _error;
+        std::thread _thread; // last, it starts once the rest is initialized
+
+        void wakeUp() {
+            // orders the push, whose position is stored relaxed, before the load of _sleeping
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_sleeping.load()) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _wakeUp.notify_one();
+            }
+        }
+
+        void handle(PostedEvent &posted) {
+            try {
+                for (auto listener : posted.listeners)
+                    listener->handle(posted.event);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error)
+                    _error = std::current_exception();
+            }
+        }
+
+        void run() {
+            for (; ;) {
+                PostedEvent *posted;
+                while (_queue.tryPop(posted)) {
+                    handle(*posted);
+                    delete posted;
+                    _handled.fetch_add(1);
+                    if (_flushing.load() > 0) {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _progress.notify_all();
+                    }
+                }
+                std::unique_lock<std::mutex> lock(_mutex);
+                _sleeping.store(true);
+                _wakeUp.wait(lock, [&] { return _stopping || !_queue.isEmpty(); });
+                _sleeping.store(false);
+                if (_stopping && _queue.isEmpty())
+                    return;
+            }
+        }
+
+        AsyncEventDispatcher(const AsyncEventDispatcher &) = delete;
+
+        AsyncEventDispatcher &operator=(const AsyncEventDispatcher &) = delete;
+
+    public:
+
+        explicit AsyncEventDispatcher(size_t capacity) :
+                _queue(capacity), _posted{0}, _handled{0}, _sleeping{false}, _flushing{0},
+                _stopping(false), _thread(&AsyncEventDispatcher::run, this) {
+        }
+
+        /**
+         * Handle the events still queued and stop the dispatcher thread. Listener exceptions are dropped.
+         */
+        ~AsyncEventDispatcher() {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wakeUp.notify_one();
+            _thread.join();
+        }
+
+        /**
+         * Queue a copy of the event: the invocation it refers to may be gone by the time it is handled.
+         */
+        void post(const UnexpectedMethodCallEvent &e, const std::vector<EventHandler *> &listeners) {
+            PostedEvent *posted = new PostedEvent(e, listeners);
+            _posted.fetch_add(1);
+            while (!_queue.tryPush(posted)) {
+                wakeUp();
+                std::this_thread::yield();
+            }
+            wakeUp();
+        }
+
+        /**
+         * Wait until the events posted so far were handled, then rethrow the first exception a listener threw.
+         * Does nothing when called by a listener, which runs on the dispatcher thread and would wait for itself.
+         */
+        void flush() {
+            if (std::this_thread::get_id() == _thread.get_id())
+                return;
+            std::unique_lock<std::mutex> lock(_mutex);
+            waitLocked(lock);
+            if (_error) {
+                std::exception_ptr error = _error;
+                _error = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * Wait until the events posted so far were handled. A listener exception is kept for the next flush().
+         */
+        void wait() {
+            if (std::this_thread::get_id() == _thread.get_id())
+                return;
+            std::unique_lock<std::mutex> lock(_mutex);
+            waitLocked(lock);
+        }
+
+    private:
+
+        void waitLocked(std::unique_lock<std::mutex> &lock) {
+            unsigned long long posted = _posted.load();
+            _flushing.fetch_add(1);
+            _progress.wait(lock, [&] { return _handled.load() >= posted; });
+            _flushing.fetch_sub(1);
+        }
+    };
+
+    /**
+     * The async event dispatch of a context, when it is enabled. Shared with the mocks, so a mock destroyed
+     * or reset waits for the events raised so far, even when it outlives its context.
+     */
+    class AsyncEventDispatch {
+        std::unique_ptr<AsyncEventDispatcher> _dispatcher;
+
+    public:
+
+        bool isEnabled() const {
+            return _dispatcher != nullptr;
+        }
+
+        void enable(size_t capacity) {
+            disable();
+            _dispatcher.reset(new AsyncEventDispatcher(capacity));
+        }
+
+        void disable() {
+            std::unique_ptr<AsyncEventDispatcher> dispatcher(std::move(_dispatcher));
+            if (dispatcher)
+                dispatcher->flush();
+        }
+
+        /**
+         * Handle the queued events and stop, dropping listener exceptions.
+         */
+        void stop() NO_THROWS {
+            _dispatcher.reset();
+        }
+
+        void post(const UnexpectedMethodCallEvent &e, const std::vector<EventHandler *> &listeners) {
+            _dispatcher->post(e, listeners);
+        }
+
+        void flush() {
+            if (_dispatcher)
+                _dispatcher->flush();
+        }
+
+        void wait() {
+            if (_dispatcher)
+                _dispatcher->wait();
+        }
+    };
+
+}
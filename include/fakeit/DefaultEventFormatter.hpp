@@ -18,7 +18,8 @@ namespace fakeit {
         virtual std::string format(const UnexpectedMethodCallEvent &e) override {
             std::ostringstream out;
             out << "Unexpected method invocation: ";
-            out << e.getInvocation().format() << std::endl;
+            e.getInvocation().format(out);
+            out << std::endl;
             if (UnexpectedType::Unmatched == e.getUnexpectedType()) {
                 out << "  Could not find Any recorded behavior to support this method call.";
             } else {
@@ -105,7 +106,7 @@ namespace fakeit {
             for (unsigned int i = 0; i < max_size; i++) {
                 out << "  ";
                 auto invocation = actualSequence[i];
-                out << invocation->format();
+                invocation->format(out);
                 if (i < max_size - 1)
                     out << std::endl;
             }
@@ -8,11 +8,102 @@
 #pragma once
 
 #include <string>
+#include <ostream>
+#include <stdexcept>
+
+#include "mockutils/InternedString.hpp"
 
 namespace fakeit {
 
     struct FakeitContext;
 
+    class InvocationTraceWriter;
+
+    /**
+     * Pass to the Mock constructor to create a mock that does not record its invocations.
+     * Stubbed methods are dispatched as usual, but the mock can not be verified.
+     */
+    struct NoRecordingMode {
+    } static NoRecording;
+
+    /**
+     * Pass to the Mock constructor to keep only the last count invocations of each method.
+     * Older invocations are dropped but still counted, so Verify(Method(mock,foo)).Exactly(n) keeps working.
+     * Other verifications use the retained invocations and fail with std::invalid_argument when those
+     * are not enough to decide the result.
+     * A dropped invocation is verified only by such a count of all the invocations of its method, or by a
+     * verification made before it was dropped. VerifyNoOtherInvocations fails with std::invalid_argument
+     * while a dropped invocation is not verified.
+     */
+    struct KeepLast {
+        explicit KeepLast(unsigned int count) : count(count) {
+            if (count == 0)
+                throw std::invalid_argument("KeepLast needs a count of at least 1");
+        }
+
+        unsigned int count;
+    };
+
+    /**
+     * Pass to the Mock constructor to create a mock that can be called from several threads at once.
+     * Each thread records its invocations in its own log, so concurrent calls don't contend on a lock.
+     * Stubbing and verification must not run concurrently with calls to the mock: stub before the
+     * threads start and verify after they are joined.
+     */
+    struct ThreadSafeMode {
+    } static ThreadSafe;
+
+    struct TracingMode {
+        InvocationTraceWriter *writer;
+    };
+
+    /**
+     * Pass TraceTo(writer) to the Mock constructor to append the invocations of its methods to a trace instead
+     * of keeping them. The mock can not be verified: replay the trace into another mock with ReplayTrace and
+     * verify that one.
+     */
+    inline TracingMode TraceTo(InvocationTraceWriter &writer) {
+        return TracingMode{&writer};
+    }
+
+    /**
+     * How a mock records the invocations of its methods.
+     */
+    struct RecordingOptions {
+        RecordingOptions() : isRecording(true), isThreadSafe(false), historyLimit(0), trace(nullptr) { }
+
+        RecordingOptions(NoRecordingMode) : isRecording(false), isThreadSafe(false), historyLimit(0), trace(nullptr) { }
+
+        RecordingOptions(KeepLast keepLast) :
+                isRecording(true), isThreadSafe(false), historyLimit(keepLast.count), trace(nullptr) { }
+
+        RecordingOptions(ThreadSafeMode) : isRecording(true), isThreadSafe(true), historyLimit(0), trace(nullptr) { }
+
+        RecordingOptions(TracingMode tracing) :
+                isRecording(false), isThreadSafe(false), historyLimit(0), trace(tracing.writer) { }
+
+        bool isRecording;
+        bool isThreadSafe;
+        unsigned int historyLimit; // 0 for an unbounded history
+        InvocationTraceWriter *trace; // null unless invocations are traced
+    };
+
+    /**
+     * What the recorded invocations of a method keep of their arguments once the call returns.
+     * Set per method with Method(mock,foo).Capture(...). Reset() of the mock restores ByValue.
+     */
+    enum class ArgumentsCapture {
+        // The arguments as the method received them: parameters passed by value are kept by value and
+        // reference parameters by reference. This is the default.
+        ByValue,
+        // Nothing. The arguments are referred to in place during the call and released when it returns.
+        // Verify can only match such invocations without argument matchers.
+        ByReference,
+        // A hash of the arguments, which must all have a std::hash. Verify can match such invocations without
+        // argument matchers, or with matchers of equal values only (plain values and Eq).
+        ByFingerprint
+    };
+
     template<typename C>
     struct MockObject {
         virtual ~MockObject() THROWS { };
@@ -29,24 +120,75 @@ namespace fakeit {
             return ++ordinal;
         }
 
-        MethodInfo(unsigned int anId, std::string aName) :
-                _id(anId), _name(aName) { }
+        MethodInfo(unsigned int anId, InternedString aName) :
+                _id(anId), _methodName(std::move(aName)), _unverifiedInvocations(nullptr) { }
+
+        /**
+         * The same method of another mock. Its mock name is set once the mock is named by Method(mock,foo).
+         */
+        MethodInfo(unsigned int anId, const MethodInfo &namedLike) :
+                _id(anId), _methodName(namedLike._methodName), _unverifiedInvocations(nullptr) { }
 
         unsigned int id() const {
             return _id;
         }
 
+        /**
+         * The full name, "mock.method" once the mock name is known. Built on each call: prefer formatName.
+         */
         std::string name() const {
-            return _name;
+            if (_mockName.empty())
+                return _methodName.str();
+            return _mockName.str() + "." + _methodName.str();
+        }
+
+        InternedString mockName() const {
+            return _mockName;
+        }
+
+        InternedString methodName() const {
+            return _methodName;
+        }
+
+        void formatName(std::ostream &out) const {
+            if (!_mockName.empty())
+                out << _mockName << '.';
+            out << _methodName;
+        }
+
+        void setName(InternedString value) {
+            _mockName = InternedString();
+            _methodName = std::move(value);
+        }
+
+        void setName(InternedString mockName, InternedString methodName) {
+            _mockName = std::move(mockName);
+            _methodName = std::move(methodName);
+        }
+
+        /**
+         * Recorded invocations of this method that are not verified yet are counted in the given counter,
+         * which is shared by all the methods of a mock.
+         */
+        void setUnverifiedInvocationsCounter(unsigned int *counter) {
+            _unverifiedInvocations = counter;
+        }
+
+        void addUnverifiedInvocation() {
+            if (_unverifiedInvocations)
+                ++*_unverifiedInvocations;
         }
 
-        void setName(const std::string &value) {
-            _name = value;
+        void removeUnverifiedInvocation() {
+            if (_unverifiedInvocations)
+                --*_unverifiedInvocations;
         }
 
     private:
         unsigned int _id;
-        std::string _name;
+        InternedString _mockName;
+        InternedString _methodName;
+        unsigned int *_unverifiedInvocations;
     };
 
     struct UnknownMethod {
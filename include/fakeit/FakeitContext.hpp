@@ -9,14 +9,20 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <ostream>
 #include "fakeit/EventHandler.hpp"
 #include "fakeit/EventFormatter.hpp"
+#include "fakeit/AsyncEventDispatcher.hpp"
+#include "fakeit/MethodStatistics.hpp"
 
 namespace fakeit {
 
     struct FakeitContext : public EventHandler, protected EventFormatter {
 
-        virtual ~FakeitContext() = default;
+        virtual ~FakeitContext() {
+            _dispatch->stop();
+        }
 
         void handle(const UnexpectedMethodCallEvent &e) override {
             fireEvent(e);
@@ -25,12 +31,14 @@ namespace fakeit {
         }
 
         void handle(const SequenceVerificationEvent &e) override {
+            flushEvents();
             fireEvent(e);
             auto &eh = getTestingFrameworkAdapter();
             return eh.handle(e);
         }
 
         void handle(const NoMoreInvocationsVerificationEvent &e) override {
+            flushEvents();
             fireEvent(e);
             auto &eh = getTestingFrameworkAdapter();
             return eh.handle(e);
@@ -55,10 +63,73 @@ namespace fakeit {
             _eventListeners.push_back(&eventListener);
         }
 
+        /**
+         * Waits for the queued events first, so the listeners can be destroyed once it returns.
+         */
         void clearEventHandlers() {
+            flushEvents();
             _eventListeners.clear();
         }
 
+        /**
+         * Hand unexpected call events to the listeners on a background thread instead of the thread of the
+         * mocked call, through a queue of the given capacity. Verification events stay synchronous. Every
+         * verification first waits for the queued events, so listeners see all events in order and a listener
+         * exception is thrown by the next Verify. Destroying or resetting a mock also waits for them.
+         * Enable it before the mocks are called.
+         */
+        void enableAsyncEventDispatch(size_t capacity = 1024) {
+            _dispatch->enable(capacity);
+        }
+
+        /**
+         * Wait for the queued events and hand the next ones to the listeners synchronously again.
+         */
+        void disableAsyncEventDispatch() {
+            _dispatch->disable();
+        }
+
+        /**
+         * Wait until the listeners handled the events raised so far. Rethrows the first exception a listener
+         * threw on the dispatcher thread. Does nothing unless async event dispatch is enabled.
+         */
+        void flushEvents() {
+            _dispatch->flush();
+        }
+
+        /**
+         * Shared with the mocks, so a mock destroyed after its context doesn't wait on a dispatcher that is gone.
+         */
+        std::shared_ptr<AsyncEventDispatch> getAsyncEventDispatch() {
+            return _dispatch;
+        }
+
+        /**
+         * The call statistics of every mocked method of this context that was called, including the methods of
+         * mocks that were destroyed or reset since. Methods are summed by name and sorted by name.
+         */
+        std::vector<MethodStatistics> getMethodStatistics() {
+            return _callStatistics->collect();
+        }
+
+        /**
+         * Print the call statistics as a table, the methods that took the most time first.
+         */
+        void dumpMethodStatistics(std::ostream &out) {
+            _callStatistics->dump(out);
+        }
+
+        void clearMethodStatistics() {
+            _callStatistics->clear();
+        }
+
+        /**
+         * Shared with the mocks, so a mock destroyed after its context can still hand its statistics over.
+         */
+        std::shared_ptr<CallStatistics> getCallStatistics() {
+            return _callStatistics;
+        }
+
     protected:
         virtual EventHandler &getTestingFrameworkAdapter() = 0;
 
@@ -66,6 +137,8 @@ namespace fakeit {
 
     private:
         std::vector<EventHandler *> _eventListeners;
+        std::shared_ptr<CallStatistics> _callStatistics{std::make_shared<CallStatistics>()};
+        std::shared_ptr<AsyncEventDispatch> _dispatch{std::make_shared<AsyncEventDispatch>()};
 
         void fireEvent(const NoMoreInvocationsVerificationEvent &evt) {
             for (auto listener : _eventListeners)
@@ -73,6 +146,10 @@ namespace fakeit {
         }
 
         void fireEvent(const UnexpectedMethodCallEvent &evt) {
+            if (_dispatch->isEnabled() && !_eventListeners.empty()) {
+                _dispatch->post(evt, _eventListeners);
+                return;
+            }
             for (auto listener : _eventListeners)
                 listener->handle(evt);
         }
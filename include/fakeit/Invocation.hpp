@@ -10,7 +10,7 @@
 #include <typeinfo>
 #include <tuple>
 #include <string>
-#include <iosfwd>
+#include <ostream>
 #include <sstream>
 
 #include "fakeit/DomainObjects.hpp"
@@ -50,7 +50,10 @@ namespace fakeit {
         }
 
         void markAsVerified() {
-            _isVerified = true;
+            if (!_isVerified) {
+                _isVerified = true;
+                _method.removeUnverifiedInvocation();
+            }
         }
 
         bool isVerified() const {
@@ -59,6 +62,13 @@ namespace fakeit {
 
         virtual std::string format() const = 0;
 
+        /**
+         * Write format() to out.
+         */
+        virtual void format(std::ostream &out) const {
+            out << format();
+        }
+
     private:
         const unsigned int _ordinal;
         MethodInfo &_method;
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "mockutils/TraceCodec.hpp"
+#include "fakeit/DomainObjects.hpp"
+
+namespace fakeit {
+
+    /**
+     * What a traced invocation keeps of its arguments.
+     */
+    enum class TracedArguments : unsigned char {
+        None = 0,        // nothing, as ArgumentsCapture::ByReference
+        Fingerprint = 1, // their hash, as ArgumentsCapture::ByFingerprint
+        Values = 2       // their values, written with TraceCodec
+    };
+
+    /**
+     * A trace is a header followed by records. A record is a kind byte, the size of its content and the content.
+     * A method record declares a traced method before its first invocation record.
+     */
+    struct InvocationTraceFormat {
+        static const uint32_t MAGIC = 0x52544B46; // "FKTR"
+        static const uint32_t VERSION = 1;
+
+        enum Record : unsigned char {
+            Method = 1,     // id, mock name, method name, signature
+            Invocation = 2  // method id, ordinal, TracedArguments, arguments
+        };
+    };
+
+    /**
+     * A method that traced invocations can be added to, as if they were made to it.
+     */
+    struct TraceReplayTarget {
+
+        virtual ~TraceReplayTarget() = default;
+
+        virtual MethodInfo &getMethod() = 0;
+
+        /**
+         * Identifies the parameter and return types of the method. Only invocations of a traced method with
+         * the same name and signature are replayed into it.
+         */
+        virtual const char *getTraceSignature() const = 0;
+
+        /**
+         * Add an invocation, read in the order of the trace, with a fresh ordinal: the traced one belongs to
+         * another run and could collide with the ordinals of this one.
+         */
+        virtual void replayInvocation(TracedArguments encoding, TraceInput &arguments) = 0;
+    };
+
+    /**
+     * Appends the invocations of traced mocks to a binary stream. Records are buffered and written to the stream
+     * in large blocks, and on flush() and destruction. Mocks on several threads may share a writer.
+     */
+    class InvocationTraceWriter {
+
+        static const size_t BLOCK_SIZE = 64 * 1024;
+
+        std::ostream &_out;
+        std::mutex _mutex;
+        TraceOutput _buffer;
+        unsigned long long _invocations;
+
+        size_t beginRecord(InvocationTraceFormat::Record kind) {
+            unsigned char k = kind;
+            _buffer.write(&k, 1);
+            size_t sizeOffset = _buffer.size();
+            _buffer.writeUInt(0);
+            return sizeOffset;
+        }
+
+        void endRecord(size_t sizeOffset) {
+            _buffer.patchUInt(sizeOffset, (uint32_t) (_buffer.size() - sizeOffset - sizeof(uint32_t)));
+            if (_buffer.size() >= BLOCK_SIZE)
+                writeBuffer();
+        }
+
+        void writeBuffer() {
+            _out.write(_buffer.data(), (std::streamsize) _buffer.size());
+            _buffer.clear();
+        }
+
+        InvocationTraceWriter(const InvocationTraceWriter &) = delete;
+
+        InvocationTraceWriter &operator=(const InvocationTraceWriter &) = delete;
+
+    public:
+
+        explicit InvocationTraceWriter(std::ostream &out) : _out(out), _invocations(0) {
+            _buffer.writeUInt(InvocationTraceFormat::MAGIC);
+            _buffer.writeUInt(InvocationTraceFormat::VERSION);
+        }
+
+        ~InvocationTraceWriter() {
+            flush();
+        }
+
+        /**
+         * Write the buffered records to the stream and flush it.
+         */
+        void flush() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            writeBuffer();
+            _out.flush();
+        }
+
+        unsigned long long getInvocationsCount() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _invocations;
+        }
+
+        void declareMethod(const MethodInfo &method, const char *signature) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            size_t sizeOffset = beginRecord(InvocationTraceFormat::Method);
+            _buffer.writeUInt(method.id());
+            _buffer.writeString(method.mockName().str());
+            _buffer.writeString(method.methodName().str());
+            _buffer.writeString(signature);
+            endRecord(sizeOffset);
+        }
+
+        /**
+         * Append an invocation of a declared method. writeArguments(TraceOutput &) writes what the encoding says.
+         */
+        template<typename F>
+        void appendInvocation(unsigned int methodId, unsigned int ordinal, TracedArguments encoding, F writeArguments) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            size_t recordOffset = _buffer.size();
+            size_t sizeOffset = beginRecord(InvocationTraceFormat::Invocation);
+            _buffer.writeUInt(methodId);
+            _buffer.writeUInt(ordinal);
+            unsigned char e = (unsigned char) encoding;
+            _buffer.write(&e, 1);
+            try {
+                writeArguments(_buffer);
+            } catch (...) {
+                _buffer.truncate(recordOffset);
+                throw;
+            }
+            endRecord(sizeOffset);
+            _invocations++;
+        }
+    };
+
+    /**
+     * Reads a trace written by InvocationTraceWriter, one record at a time, so a trace of any size is read in
+     * the memory of its largest record.
+     */
+    class InvocationTraceReader {
+
+        struct TracedMethod {
+            std::string mockName;
+            std::string methodName;
+            std::string signature;
+        };
+
+        std::istream &_in;
+        std::vector<char> _record;
+
+        bool readRecord(InvocationTraceFormat::Record &kind) {
+            unsigned char k;
+            if (!_in.read(reinterpret_cast<char *>(&k), 1))
+                return false;
+            uint32_t size;
+            if (!_in.read(reinterpret_cast<char *>(&size), sizeof(size)))
+                throw std::runtime_error("invocation trace is truncated");
+            _record.resize(size);
+            if (size > 0 && !_in.read(_record.data(), size))
+                throw std::runtime_error("invocation trace is truncated");
+            kind = (InvocationTraceFormat::Record) k;
+            return true;
+        }
+
+        TraceInput recordContent() const {
+            return TraceInput(_record.data(), _record.data() + _record.size());
+        }
+
+        /**
+         * The target for the invocations of a traced method: the one of the same mock if there is one,
+         * otherwise any method of the same name and signature.
+         */
+        static TraceReplayTarget *findTarget(const TracedMethod &traced, const std::vector<TraceReplayTarget *> &targets) {
+            TraceReplayTarget *found = nullptr;
+            for (TraceReplayTarget *target : targets) {
+                MethodInfo &method = target->getMethod();
+                if (method.methodName().str() != traced.methodName || traced.signature != target->getTraceSignature())
+                    continue;
+                if (method.mockName().str() == traced.mockName)
+                    return target;
+                if (!found)
+                    found = target;
+            }
+            return found;
+        }
+
+        InvocationTraceReader(const InvocationTraceReader &) = delete;
+
+        InvocationTraceReader &operator=(const InvocationTraceReader &) = delete;
+
+    public:
+
+        /**
+         * Throws std::invalid_argument if the stream does not start with an invocation trace header.
+         */
+        explicit InvocationTraceReader(std::istream &in) : _in(in) {
+            uint32_t header[2] = {0, 0};
+            _in.read(reinterpret_cast<char *>(header), sizeof(header));
+            if (!_in || header[0] != InvocationTraceFormat::MAGIC || header[1] != InvocationTraceFormat::VERSION)
+                throw std::invalid_argument("not an invocation trace of this version");
+        }
+
+        /**
+         * Read the rest of the trace, adding the invocations of the given methods to them.
+         * Invocations of other methods are skipped without being decoded. Returns the number of invocations added.
+         */
+        size_t replayInto(const std::vector<TraceReplayTarget *> &targets) {
+            std::unordered_map<uint32_t, TraceReplayTarget *> methods;
+            size_t replayed = 0;
+            InvocationTraceFormat::Record kind;
+            while (readRecord(kind)) {
+                TraceInput content = recordContent();
+                if (kind == InvocationTraceFormat::Method) {
+                    uint32_t id = content.readUInt();
+                    TracedMethod traced;
+                    traced.mockName = content.readString();
+                    traced.methodName = content.readString();
+                    traced.signature = content.readString();
+                    methods[id] = findTarget(traced, targets);
+                } else if (kind == InvocationTraceFormat::Invocation) {
+                    uint32_t id = content.readUInt();
+                    auto method = methods.find(id);
+                    if (method == methods.end())
+                        throw std::runtime_error("invocation trace refers to an undeclared method");
+                    if (!method->second)
+                        continue;
+                    content.readUInt(); // the ordinal of the traced run
+                    unsigned char encoding;
+                    content.read(&encoding, 1);
+                    method->second->replayInvocation((TracedArguments) encoding, content);
+                    replayed++;
+                }
+                // records of unknown kinds are skipped: a later version may add some.
+            }
+            return replayed;
+        }
+    };
+
+}
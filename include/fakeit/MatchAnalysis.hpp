@@ -6,8 +6,92 @@
 
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
 
 namespace fakeit {
+    /**
+     * Finds where a sequence ends in a stream of invocations, using the bit-parallel Shift-And algorithm.
+     * The sequence is flattened to its matchers once. Bit k of the state is set when the last k + 1 invocations
+     * match the first k + 1 matchers, so partial matches are never rechecked. Every distinct matcher is
+     * evaluated once per invocation and selects the positions it holds in the sequence, so a long sequence
+     * made of a few repeated matchers costs little more than a short one.
+     */
+    class SequenceAutomaton {
+        typedef unsigned long long Word;
+        static const unsigned int WORD_BITS = 64;
+
+        std::vector<Invocation::Matcher *> _matchers; // distinct matchers of the sequence
+        std::vector<Word> _positions; // for each distinct matcher, a bit mask of its positions in the sequence
+        unsigned int _length;
+        unsigned int _words;
+        std::vector<Word> _state;
+        std::vector<Word> _input;
+
+        Word *positionsOf(unsigned int matcher) {
+            return &_positions[matcher * _words];
+        }
+
+    public:
+
+        SequenceAutomaton(Sequence &sequence) {
+            std::vector<Invocation::Matcher *> expectedSequence;
+            sequence.getExpectedSequence(expectedSequence);
+            _length = (unsigned int) expectedSequence.size();
+            _words = (_length + WORD_BITS - 1) / WORD_BITS;
+            _state.assign(_words, 0);
+            _input.assign(_words, 0);
+
+            std::unordered_map<Invocation::Matcher *, unsigned int> indexes;
+            for (unsigned int k = 0; k < _length; k++) {
+                auto inserted = indexes.insert(std::make_pair(expectedSequence[k], (unsigned int) _matchers.size()));
+                if (inserted.second) {
+                    _matchers.push_back(expectedSequence[k]);
+                    _positions.resize(_positions.size() + _words, 0);
+                }
+                positionsOf(inserted.first->second)[k / WORD_BITS] |= Word(1) << (k % WORD_BITS);
+            }
+        }
+
+        unsigned int length() const {
+            return _length;
+        }
+
+        void reset() {
+            std::fill(_state.begin(), _state.end(), 0);
+        }
+
+        /**
+         * Advance by one invocation. Returns true if the sequence ends at this invocation.
+         */
+        bool step(Invocation &invocation) {
+            bool anyMatch = false;
+            std::fill(_input.begin(), _input.end(), 0);
+            for (unsigned int m = 0; m < _matchers.size(); m++) {
+                if (_matchers[m]->matches(invocation)) {
+                    anyMatch = true;
+                    Word *positions = positionsOf(m);
+                    for (unsigned int w = 0; w < _words; w++) {
+                        _input[w] |= positions[w];
+                    }
+                }
+            }
+            if (!anyMatch) {
+                reset();
+                return false;
+            }
+
+            Word carry = 1;
+            for (unsigned int w = 0; w < _words; w++) {
+                Word nextCarry = _state[w] >> (WORD_BITS - 1);
+                _state[w] = ((_state[w] << 1) | carry) & _input[w];
+                carry = nextCarry;
+            }
+            unsigned int last = _length - 1;
+            return ((_state[last / WORD_BITS] >> (last % WORD_BITS)) & 1) != 0;
+        }
+    };
+
     struct MatchAnalysis {
         std::vector<Invocation *> actualSequence;
         std::vector<Invocation *> matchedInvocations;
@@ -21,44 +105,45 @@ namespace fakeit {
     private:
         static void getActualInvocationSequence(InvocationsSourceProxy &involvedMocks,
                                                 std::vector<Invocation *> &actualSequence) {
-            std::unordered_set<Invocation *> actualInvocations;
-            collectActualInvocations(involvedMocks, actualInvocations);
-            InvocationUtils::sortByInvocationOrder(actualInvocations, actualSequence);
+            InvocationRuns runs;
+            involvedMocks.getActualInvocationRuns(runs);
+            InvocationUtils::mergeByInvocationOrder(runs, actualSequence);
         }
 
+        /**
+         * Count the occurrences of the pattern in a single forward pass over the actual sequence.
+         * Each sequence of the pattern must match consecutive invocations, and the sequences must follow each
+         * other in order. After a full match, the search for the next one starts right after it.
+         */
         static int countMatches(std::vector<Sequence *> &pattern, std::vector<Invocation *> &actualSequence,
                                 std::vector<Invocation *> &matchedInvocations) {
-            int end = -1;
-            int count = 0;
-            int startSearchIndex = 0;
-            while (findNextMatch(pattern, actualSequence, startSearchIndex, end, matchedInvocations)) {
-                count++;
-                startSearchIndex = end;
+            if (pattern.empty())
+                return 0;
+
+            std::vector<SequenceAutomaton> automata;
+            for (Sequence *sequence : pattern) {
+                automata.push_back(SequenceAutomaton(*sequence));
             }
-            return count;
-        }
 
-        static void collectActualInvocations(InvocationsSourceProxy &involvedMocks,
-                                             std::unordered_set<Invocation *> &actualInvocations) {
-            involvedMocks.getActualInvocations(actualInvocations);
-        }
+            int count = 0;
+            unsigned int current = 0;
+            for (unsigned int i = 0; i < actualSequence.size(); i++) {
+                SequenceAutomaton &automaton = automata[current];
+                if (!automaton.step(*actualSequence[i]))
+                    continue;
 
-        static bool findNextMatch(std::vector<Sequence *> &pattern, std::vector<Invocation *> &actualSequence,
-                                  int startSearchIndex, int &end,
-                                  std::vector<Invocation *> &matchedInvocations) {
-            for (auto sequence : pattern) {
-                int index = findNextMatch(sequence, actualSequence, startSearchIndex);
-                if (index == -1) {
-                    return false;
+                collectMatchedInvocations(actualSequence, matchedInvocations, i + 1 - automaton.length(),
+                                          automaton.length());
+                current++;
+                if (current == automata.size()) {
+                    count++;
+                    current = 0;
                 }
-                collectMatchedInvocations(actualSequence, matchedInvocations, index, sequence->size());
-                startSearchIndex = index + sequence->size();
+                automata[current].reset();
             }
-            end = startSearchIndex;
-            return true;
+            return count;
         }
 
-
         static void collectMatchedInvocations(std::vector<Invocation *> &actualSequence,
                                               std::vector<Invocation *> &matchedInvocations, int start,
                                               int length) {
@@ -67,29 +152,5 @@ namespace fakeit {
                 matchedInvocations.push_back(actualSequence[start]);
             }
         }
-
-
-        static bool isMatch(std::vector<Invocation *> &actualSequence,
-                            std::vector<Invocation::Matcher *> &expectedSequence, int start) {
-            bool found = true;
-            for (unsigned int j = 0; found && j < expectedSequence.size(); j++) {
-                Invocation *actual = actualSequence[start + j];
-                Invocation::Matcher *expected = expectedSequence[j];
-                found = found && expected->matches(*actual);
-            }
-            return found;
-        }
-
-        static int findNextMatch(Sequence *&pattern, std::vector<Invocation *> &actualSequence, int startSearchIndex) {
-            std::vector<Invocation::Matcher *> expectedSequence;
-            pattern->getExpectedSequence(expectedSequence);
-            for (int i = startSearchIndex; i < ((int) actualSequence.size() - (int) expectedSequence.size() + 1); i++) {
-                if (isMatch(actualSequence, expectedSequence, i)) {
-                    return i;
-                }
-            }
-            return -1;
-        }
-
     };
 }
@@ -20,6 +20,49 @@
 
 namespace fakeit {
 
+    /**
+     * The matcher that a Using(...) argument of type Head creates, by value, for a method argument of type T.
+     * isKnown is false when the matcher type is only known at run time, as for matcher creators that
+     * don't provide createMatcherByValue().
+     */
+    template<typename T, typename Head, typename = void>
+    struct ArgumentMatcherByValue {
+        static const bool isKnown = false;
+    };
+
+    template<typename T>
+    struct ArgumentMatcherByValue<T, AnyMatcher, void> {
+        static const bool isKnown = true;
+        typedef typename internal::TypedAnyMatcher<T>::Matcher type;
+
+        static type create(const AnyMatcher &) {
+            return type();
+        }
+    };
+
+    template<typename T, typename Head>
+    struct ArgumentMatcherByValue<T, Head, typename std::enable_if<
+            std::is_constructible<T, Head>::value && !std::is_same<AnyMatcher, Head>::value>::type> {
+        static const bool isKnown = true;
+        typedef typename internal::EqMatcherCreator<T>::Matcher type;
+
+        static type create(const Head &value) {
+            return type(T(value));
+        }
+    };
+
+    template<typename T, typename Head>
+    struct ArgumentMatcherByValue<T, Head, typename std::enable_if<
+            std::is_base_of<TypedMatcherCreator<T>, Head>::value,
+            decltype((void) std::declval<const Head &>().createMatcherByValue())>::type> {
+        static const bool isKnown = true;
+        typedef decltype(std::declval<const Head &>().createMatcherByValue()) type;
+
+        static type create(const Head &creator) {
+            return creator.createMatcherByValue();
+        }
+    };
+
     template<unsigned int index, typename ... arglist>
     class MatchersCollector {
 
@@ -16,6 +16,7 @@
 #include <unordered_set>
 #include <set>
 #include <iosfwd>
+#include <stdexcept>
 
 #include "fakeit/RecordedMethodBody.hpp"
 #include "fakeit/StubbingProgress.hpp"
@@ -61,19 +62,41 @@ namespace fakeit {
 
             virtual void scanActualInvocations(const std::function<void(ActualInvocation<arglist...> &)> &scanner) = 0;
 
-            virtual void setMethodDetails(std::string mockName, std::string methodName) = 0;
+            virtual unsigned int getInvocationsCount() = 0;
+
+            virtual bool hasDroppedInvocations() = 0;
+
+            virtual bool hasDroppedUnverifiedInvocations() = 0;
+
+            virtual void markDroppedInvocationsAsVerified() = 0;
+
+            virtual bool mayHaveUnverifiedInvocations() = 0;
+
+            virtual void setArgumentsCapture(ArgumentsCapture capture) = 0;
+
+            virtual void setMethodDetails(InternedString mockName, InternedString methodName) = 0;
 
             virtual bool isOfMethod(MethodInfo &method) = 0;
 
             virtual ActualInvocationsSource &getInvolvedMock() = 0;
+
+            virtual TraceReplayTarget &getTraceReplayTarget() = 0;
         };
 
+        /**
+         * Used only by ReplayTrace phrase.
+         */
+        TraceReplayTarget &getTraceReplayTarget() const {
+            return _impl->getTraceReplayTarget();
+        }
+
     private:
         class Implementation {
 
             Context *_stubbingContext;
             ActionSequence<R, arglist...> *_recordedActionSequence;
             typename ActualInvocation<arglist...>::Matcher *_invocationMatcher;
+            bool _isDefaultInvocationMatcher;
             bool _commited;
 
             Context &getStubbingContext() const {
@@ -87,7 +110,7 @@ namespace fakeit {
                       _recordedActionSequence(new ActionSequence<R, arglist...>()),
                       _invocationMatcher
                               {
-                                      new DefaultInvocationMatcher<arglist...>()}, _commited(false) {
+                                      new DefaultInvocationMatcher<arglist...>()}, _isDefaultInvocationMatcher(true), _commited(false) {
             }
 
             ~Implementation() {
@@ -111,13 +134,52 @@ namespace fakeit {
 
             void getActualInvocations(std::unordered_set<Invocation *> &into) const {
                 auto scanner = [&](ActualInvocation<arglist...> &a) {
-                    if (_invocationMatcher->matches(a)) {
+                    if (matchesRecorded(a)) {
                         into.insert(&a);
                     }
                 };
                 getStubbingContext().scanActualInvocations(scanner);
             }
 
+            void getActualInvocationRuns(InvocationRuns &into) const {
+                // the scan is ordered within each recording log (one per thread for a ThreadSafe mock),
+                // so a new run starts wherever the ordinals go back.
+                size_t firstRun = into.size();
+                auto scanner = [&](ActualInvocation<arglist...> &a) {
+                    if (!matchesRecorded(a)) {
+                        return;
+                    }
+                    if (into.size() == firstRun || into.back().back()->getOrdinal() > a.getOrdinal()) {
+                        into.emplace_back();
+                    }
+                    into.back().push_back(&a);
+                };
+                getStubbingContext().scanActualInvocations(scanner);
+            }
+
+            bool countInvocations(unsigned int &count) const {
+                if (!_isDefaultInvocationMatcher)
+                    return false;
+                count = getStubbingContext().getInvocationsCount();
+                return true;
+            }
+
+            bool hasDroppedInvocations() const {
+                return getStubbingContext().hasDroppedInvocations();
+            }
+
+            bool hasDroppedUnverifiedInvocations() const {
+                return getStubbingContext().hasDroppedUnverifiedInvocations();
+            }
+
+            void markDroppedInvocationsAsVerified() {
+                getStubbingContext().markDroppedInvocationsAsVerified();
+            }
+
+            bool mayHaveUnverifiedInvocations() const {
+                return getStubbingContext().mayHaveUnverifiedInvocations();
+            }
+
             /**
              * Used only by Verify phrase.
              */
@@ -128,7 +190,27 @@ namespace fakeit {
                 }
 
                 ActualInvocation<arglist...> &actualInvocation = dynamic_cast<ActualInvocation<arglist...> &>(invocation);
-                return _invocationMatcher->matches(actualInvocation);
+                return matchesRecorded(actualInvocation);
+            }
+
+            /**
+             * Match a recorded invocation, whose arguments may not be captured.
+             */
+            bool matchesRecorded(ActualInvocation<arglist...> &invocation) const {
+                if (invocation.hasArguments())
+                    return _invocationMatcher->matches(invocation);
+                if (_isDefaultInvocationMatcher)
+                    return true;
+                size_t fingerprint;
+                size_t expected;
+                if (invocation.getFingerprint(fingerprint) && _invocationMatcher->getExpectedArgumentsHash(expected))
+                    return fingerprint == expected;
+                throw std::invalid_argument(std::string("can't verify ").append(format())
+                                                    .append(": the arguments of its invocations are not captured"));
+            }
+
+            void setArgumentsCapture(ArgumentsCapture capture) {
+                getStubbingContext().setArgumentsCapture(capture);
             }
 
             void commit() {
@@ -145,7 +227,7 @@ namespace fakeit {
                 commit();
             }
 
-            void setMethodDetails(std::string mockName, std::string methodName) {
+            void setMethodDetails(InternedString mockName, InternedString methodName) {
                 getStubbingContext().setMethodDetails(mockName, methodName);
             }
 
@@ -153,6 +235,10 @@ namespace fakeit {
                 into.push_back(&getStubbingContext().getInvolvedMock());
             }
 
+            TraceReplayTarget &getTraceReplayTarget() const {
+                return getStubbingContext().getTraceReplayTarget();
+            }
+
             typename std::function<R(arglist &...)> getOriginalMethod() {
                 return getStubbingContext().getOriginalMethod();
             }
@@ -160,6 +246,7 @@ namespace fakeit {
             void setInvocationMatcher(typename ActualInvocation<arglist...>::Matcher *matcher) {
                 delete _invocationMatcher;
                 _invocationMatcher = matcher;
+                _isDefaultInvocationMatcher = false;
             }
         };
 
@@ -207,6 +294,39 @@ namespace fakeit {
             _impl->getActualInvocations(into);
         }
 
+        /**
+         * Used only by Verify phrase.
+         */
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            _impl->getActualInvocationRuns(into);
+        }
+
+        /**
+         * Used only by Verify phrase.
+         */
+        bool countInvocations(unsigned int &count) const override {
+            return _impl->countInvocations(count);
+        }
+
+        bool hasDroppedInvocations() const override {
+            return _impl->hasDroppedInvocations();
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            return _impl->hasDroppedUnverifiedInvocations();
+        }
+
+        /**
+         * Used only by Verify phrase, once a verification passed on countInvocations.
+         */
+        void markDroppedInvocationsAsVerified() const override {
+            _impl->markDroppedInvocationsAsVerified();
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            return _impl->mayHaveUnverifiedInvocations();
+        }
+
         /**
          * Used only by Verify phrase.
          */
@@ -218,10 +338,14 @@ namespace fakeit {
             _impl->commit();
         }
 
-        void setMethodDetails(std::string mockName, std::string methodName) {
+        void setMethodDetails(InternedString mockName, InternedString methodName) {
             _impl->setMethodDetails(mockName, methodName);
         }
 
+        void setArgumentsCapture(ArgumentsCapture capture) {
+            _impl->setArgumentsCapture(capture);
+        }
+
         void setMatchingCriteria(std::function<bool(arglist &...)> predicate) {
             typename ActualInvocation<arglist...>::Matcher *matcher{
                     new UserDefinedInvocationMatcher<arglist...>(predicate)};
@@ -248,6 +372,25 @@ namespace fakeit {
         template<class ...matcherCreators, class = typename std::enable_if<
                 sizeof...(matcherCreators) == sizeof...(arglist)>::type>
         void setMatchingCriteria(const matcherCreators &... matcherCreator) {
+            setArgumentMatchers(all_true<ArgumentMatcherByValue<
+                    typename naked_type<arglist>::type, matcherCreators>::isKnown...>(), matcherCreator...);
+        }
+
+    private:
+
+        template<class ...matcherCreators>
+        void setArgumentMatchers(std::true_type, const matcherCreators &... matcherCreator) {
+            typedef std::tuple<typename ArgumentMatcherByValue<
+                    typename naked_type<arglist>::type, matcherCreators>::type...> Matchers;
+            typename ActualInvocation<arglist...>::Matcher *matcher{
+                    new TypedArgumentsMatcherInvocationMatcher<Matchers, arglist...>(Matchers(
+                            ArgumentMatcherByValue<typename naked_type<arglist>::type, matcherCreators>::create(
+                                    matcherCreator)...))};
+            _impl->setInvocationMatcher(matcher);
+        }
+
+        template<class ...matcherCreators>
+        void setArgumentMatchers(std::false_type, const matcherCreators &... matcherCreator) {
             std::vector<Destructible *> matchers;
 
             MatchersCollector<0, arglist...> c(matchers);
@@ -256,8 +399,6 @@ namespace fakeit {
             MethodMockingContext<R, arglist...>::setMatchingCriteria(matchers);
         }
 
-    private:
-
         typename std::function<R(arglist&...)> getOriginalMethod() override {
             return _impl->getOriginalMethod();
         }
@@ -282,11 +423,19 @@ namespace fakeit {
                 : MethodMockingContext<R, arglist...>(std::move(other)) {
         }
 
-        MockingContext<R, arglist...> &setMethodDetails(std::string mockName, std::string methodName) {
+        MockingContext<R, arglist...> &setMethodDetails(InternedString mockName, InternedString methodName) {
             MethodMockingContext<R, arglist...>::setMethodDetails(mockName, methodName);
             return *this;
         }
 
+        /**
+         * Choose what the invocations of this method recorded from now on keep of their arguments.
+         */
+        MockingContext<R, arglist...> &Capture(ArgumentsCapture capture) {
+            MethodMockingContext<R, arglist...>::setArgumentsCapture(capture);
+            return *this;
+        }
+
         MockingContext<R, arglist...> &Using(const arglist &... args) {
             MethodMockingContext<R, arglist...>::setMatchingCriteria(args...);
             return *this;
@@ -347,11 +496,19 @@ namespace fakeit {
                 : MethodMockingContext<void, arglist...>(std::move(other)) {
         }
 
-        MockingContext<void, arglist...> &setMethodDetails(std::string mockName, std::string methodName) {
+        MockingContext<void, arglist...> &setMethodDetails(InternedString mockName, InternedString methodName) {
             MethodMockingContext<void, arglist...>::setMethodDetails(mockName, methodName);
             return *this;
         }
 
+        /**
+         * Choose what the invocations of this method recorded from now on keep of their arguments.
+         */
+        MockingContext<void, arglist...> &Capture(ArgumentsCapture capture) {
+            MethodMockingContext<void, arglist...>::setArgumentsCapture(capture);
+            return *this;
+        }
+
         MockingContext<void, arglist...> &Using(const arglist &... args) {
             MethodMockingContext<void, arglist...>::setMatchingCriteria(args...);
             return *this;
@@ -401,7 +558,7 @@ namespace fakeit {
             MethodMockingContext<void>::setMethodBodyByAssignment(method);
         }
 
-        DtorMockingContext &setMethodDetails(std::string mockName, std::string methodName) {
+        DtorMockingContext &setMethodDetails(InternedString mockName, InternedString methodName) {
             MethodMockingContext<void>::setMethodDetails(mockName, methodName);
             return *this;
         }
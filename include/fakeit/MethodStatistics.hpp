@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include <ostream>
+#include <iomanip>
+#include <unordered_map>
+#include <utility>
+
+#include "mockutils/InternedString.hpp"
+
+namespace fakeit {
+
+    /**
+     * How much a mocked method was used.
+     * Times are only measured when FAKEIT_TIME_CALLS is defined, otherwise they are 0.
+     */
+    struct MethodStatistics {
+        MethodStatistics() : calls(0), unmatchedCalls(0), matchingNanos(0), actionNanos(0), capturedArgumentBytes(0) {
+        }
+
+        std::string name; // "mock.method"
+        unsigned long long calls;
+        unsigned long long unmatchedCalls; // calls that no clause (or no action left in it) answered
+        unsigned long long matchingNanos; // finding the clause that matches the arguments
+        unsigned long long actionNanos; // running the action of the clause, the user code included
+        unsigned long long capturedArgumentBytes; // kept in the invocation log, see ArgumentsCapture
+
+        unsigned long long matchedCalls() const {
+            return calls - unmatchedCalls;
+        }
+
+        MethodStatistics &operator+=(const MethodStatistics &other) {
+            calls += other.calls;
+            unmatchedCalls += other.unmatchedCalls;
+            matchingNanos += other.matchingNanos;
+            actionNanos += other.actionNanos;
+            capturedArgumentBytes += other.capturedArgumentBytes;
+            return *this;
+        }
+    };
+
+    /**
+     * The counters of one method, updated on each call.
+     * Counters are relaxed atomics: they order nothing, and a snapshot taken while calls are in progress may
+     * miss some of them. Only a ThreadSafe mock, whose methods are called from several threads, pays for an
+     * atomic increment. Other mocks load and store.
+     */
+    class CallCounters {
+        std::atomic<unsigned long long> _calls;
+        std::atomic<unsigned long long> _unmatchedCalls;
+        std::atomic<unsigned long long> _matchingNanos;
+        std::atomic<unsigned long long> _actionNanos;
+        std::atomic<unsigned long long> _capturedArgumentBytes;
+        const bool _isShared;
+
+        void add(std::atomic<unsigned long long> &counter, unsigned long long value) {
+            if (_isShared)
+                counter.fetch_add(value, std::memory_order_relaxed);
+            else
+                counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    public:
+        explicit CallCounters(bool isShared) :
+                _calls{0}, _unmatchedCalls{0}, _matchingNanos{0}, _actionNanos{0}, _capturedArgumentBytes{0},
+                _isShared(isShared) {
+        }
+
+        void countCall() {
+            add(_calls, 1);
+        }
+
+        void countUnmatchedCall() {
+            add(_unmatchedCalls, 1);
+        }
+
+        void addMatchingTime(unsigned long long nanos) {
+            add(_matchingNanos, nanos);
+        }
+
+        void addActionTime(unsigned long long nanos) {
+            add(_actionNanos, nanos);
+        }
+
+        void addCapturedArgumentBytes(unsigned long long bytes) {
+            add(_capturedArgumentBytes, bytes);
+        }
+
+        bool isEmpty() const {
+            return _calls.load(std::memory_order_relaxed) == 0;
+        }
+
+        void snapshot(MethodStatistics &into) const {
+            into.calls = _calls.load(std::memory_order_relaxed);
+            into.unmatchedCalls = _unmatchedCalls.load(std::memory_order_relaxed);
+            into.matchingNanos = _matchingNanos.load(std::memory_order_relaxed);
+            into.actionNanos = _actionNanos.load(std::memory_order_relaxed);
+            into.capturedArgumentBytes = _capturedArgumentBytes.load(std::memory_order_relaxed);
+        }
+
+        void clear() {
+            _calls.store(0, std::memory_order_relaxed);
+            _unmatchedCalls.store(0, std::memory_order_relaxed);
+            _matchingNanos.store(0, std::memory_order_relaxed);
+            _actionNanos.store(0, std::memory_order_relaxed);
+            _capturedArgumentBytes.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * Adds the time from its creation to its destruction to a counter, when FAKEIT_TIME_CALLS is defined.
+     * Otherwise it does nothing and compiles to nothing.
+     */
+    class CallTimer {
+#ifdef FAKEIT_TIME_CALLS
+        typedef std::chrono::steady_clock Clock;
+
+        CallCounters &_counters;
+        void (CallCounters::*_add)(unsigned long long);
+        Clock::time_point _start;
+
+    public:
+        CallTimer(CallCounters &counters, void (CallCounters::*add)(unsigned long long)) :
+                _counters(counters), _add(add), _start(Clock::now()) {
+        }
+
+        ~CallTimer() {
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+            (_counters.*_add)((unsigned long long) nanos);
+        }
+#else
+    public:
+        CallTimer(CallCounters &, void (CallCounters::*)(unsigned long long)) {
+        }
+#endif
+    };
+
+    /**
+     * The statistics of a method, with the names they are summed by. The full name of the method is only
+     * built when the statistics are read.
+     */
+    struct NamedStatistics {
+        InternedString mockName;
+        InternedString methodName;
+        MethodStatistics statistics;
+
+        std::string name() const {
+            if (mockName.empty())
+                return methodName.str();
+            return mockName.str() + "." + methodName.str();
+        }
+    };
+
+    /**
+     * Something with method statistics to report: a mock reports the methods it has.
+     */
+    struct StatisticsSource {
+
+        virtual ~StatisticsSource() = default;
+
+        /**
+         * Append the statistics of the methods that were called.
+         */
+        virtual void collectStatistics(std::vector<NamedStatistics> &into) const = 0;
+
+        virtual void clearStatistics() = 0;
+    };
+
+    class CallStatistics;
+
+    /**
+     * A source listed by a CallStatistics. The list links its sources in place, so adding and removing one
+     * allocates nothing and takes constant time.
+     */
+    class ListedStatisticsSource : public StatisticsSource {
+        friend class CallStatistics;
+
+        ListedStatisticsSource *_previousSource = nullptr;
+        ListedStatisticsSource *_nextSource = nullptr;
+    };
+
+    /**
+     * The method statistics of all the mocks of a context.
+     * Live mocks are asked for theirs on each collection. A mock that is destroyed or reset first hands its
+     * statistics over, and they are kept summed by method name, so a run of many tests shows which mocked
+     * methods are used the most even though each test has its own mocks.
+     */
+    class CallStatistics {
+        struct NamesHash {
+            size_t operator()(const std::pair<InternedString, InternedString> &names) const {
+                return InternedString::Hash()(names.first) * 31 + InternedString::Hash()(names.second);
+            }
+        };
+
+        std::mutex _mutex;
+        ListedStatisticsSource *_sources = nullptr;
+        // by mock and method name; the full names are only built by collect().
+        std::unordered_map<std::pair<InternedString, InternedString>, MethodStatistics, NamesHash> _retired;
+
+        void retireLocked(StatisticsSource &source) {
+            std::vector<NamedStatistics> statistics;
+            source.collectStatistics(statistics);
+            if (statistics.empty())
+                return;
+            for (const NamedStatistics &method : statistics) {
+                _retired[std::make_pair(method.mockName, method.methodName)] += method.statistics;
+            }
+            source.clearStatistics();
+        }
+
+    public:
+
+        void add(ListedStatisticsSource &source) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            source._previousSource = nullptr;
+            source._nextSource = _sources;
+            if (_sources)
+                _sources->_previousSource = &source;
+            _sources = &source;
+        }
+
+        /**
+         * Forget a source, keeping its statistics.
+         */
+        void remove(ListedStatisticsSource &source) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            retireLocked(source);
+            if (source._previousSource)
+                source._previousSource->_nextSource = source._nextSource;
+            else
+                _sources = source._nextSource;
+            if (source._nextSource)
+                source._nextSource->_previousSource = source._previousSource;
+            source._previousSource = nullptr;
+            source._nextSource = nullptr;
+        }
+
+        /**
+         * Keep the statistics of a source and clear them in the source, as when a mock is reset.
+         */
+        void retire(StatisticsSource &source) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            retireLocked(source);
+        }
+
+        /**
+         * The statistics of all the methods that were called, summed by name and sorted by name.
+         */
+        std::vector<MethodStatistics> collect() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::vector<NamedStatistics> all;
+            for (auto &entry : _retired) {
+                all.push_back(NamedStatistics{entry.first.first, entry.first.second, entry.second});
+            }
+            for (ListedStatisticsSource *source = _sources; source; source = source->_nextSource) {
+                source->collectStatistics(all);
+            }
+            std::map<std::string, MethodStatistics> sums;
+            for (const NamedStatistics &method : all) {
+                std::string name = method.name();
+                MethodStatistics &sum = sums[name];
+                sum.name = name;
+                sum += method.statistics;
+            }
+            std::vector<MethodStatistics> result;
+            result.reserve(sums.size());
+            for (auto &entry : sums) {
+                result.push_back(entry.second);
+            }
+            return result;
+        }
+
+        /**
+         * Forget the statistics collected so far, of live mocks included.
+         */
+        void clear() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _retired.clear();
+            for (ListedStatisticsSource *source = _sources; source; source = source->_nextSource) {
+                source->clearStatistics();
+            }
+        }
+
+        /**
+         * A table of the statistics, the methods that took the most time first, then the most called ones.
+         */
+        void dump(std::ostream &out) {
+            std::vector<MethodStatistics> statistics = collect();
+            std::stable_sort(statistics.begin(), statistics.end(), [](const MethodStatistics &a, const MethodStatistics &b) {
+                unsigned long long aNanos = a.matchingNanos + a.actionNanos;
+                unsigned long long bNanos = b.matchingNanos + b.actionNanos;
+                return aNanos != bNanos ? aNanos > bNanos : a.calls > b.calls;
+            });
+            out << std::left << std::setw(40) << "method" << std::right
+                << std::setw(12) << "calls" << std::setw(12) << "matched" << std::setw(12) << "unmatched"
+                << std::setw(14) << "matching ns" << std::setw(14) << "action ns" << std::setw(16) << "captured bytes"
+                << std::endl;
+            for (const MethodStatistics &method : statistics) {
+                out << std::left << std::setw(40) << method.name << std::right
+                    << std::setw(12) << method.calls << std::setw(12) << method.matchedCalls()
+                    << std::setw(12) << method.unmatchedCalls << std::setw(14) << method.matchingNanos
+                    << std::setw(14) << method.actionNanos << std::setw(16) << method.capturedArgumentBytes
+                    << std::endl;
+            }
+        }
+    };
+
+}
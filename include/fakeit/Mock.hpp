@@ -18,6 +18,14 @@ namespace fakeit {
     using namespace fakeit;
     using namespace fakeit::internal;
 
+    template<typename C, typename ... baseclasses>
+    class Mock;
+
+    template<typename C, typename ... baseclasses>
+    struct StubbingTemplate {
+        Mock<C, baseclasses...> &mock;
+    };
+
     template<typename C, typename ... baseclasses>
     class Mock : public ActualInvocationsSource {
         MockImpl<C, baseclasses...> impl;
@@ -32,6 +40,24 @@ namespace fakeit {
         explicit Mock(C &obj) : impl(Fakeit, obj) {
         }
 
+        explicit Mock(RecordingOptions options) : impl(Fakeit, options) {
+        }
+
+        Mock(C &obj, RecordingOptions options) : impl(Fakeit, obj, options) {
+        }
+
+        /**
+         * A fake stubbed like another mock: Mock<I> mock(StubbedLike(prototype)).
+         * The stubbing is shared rather than copied, so creating many mocks from one template allocates no
+         * matchers or actions. Each mock goes through a sequence of actions, like Return(1, 2), on its own, from
+         * where the template was when the mock was created. Stubbing a method of either mock later, or resetting
+         * it, only applies to that mock.
+         * Invocations are recorded per mock. Only methods are taken from the template, not stubbed data members.
+         */
+        explicit Mock(StubbingTemplate<C, baseclasses...> stubbingTemplate, RecordingOptions options = RecordingOptions())
+                : impl(Fakeit, stubbingTemplate.mock.impl, options) {
+        }
+
         virtual C &get() {
             return impl.get();
         }
@@ -113,6 +139,27 @@ namespace fakeit {
             impl.getActualInvocations(into);
         }
 
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            impl.getActualInvocationRuns(into);
+        }
+
+        bool hasDroppedInvocations() const override {
+            return impl.hasDroppedInvocations();
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            return impl.hasDroppedUnverifiedInvocations();
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            return impl.mayHaveUnverifiedInvocations();
+        }
+
     };
 
+    template<typename C, typename ... baseclasses>
+    StubbingTemplate<C, baseclasses...> StubbedLike(Mock<C, baseclasses...> &mock) {
+        return StubbingTemplate<C, baseclasses...>{mock};
+    }
+
 }
\ No newline at end of file
@@ -24,20 +24,33 @@ namespace fakeit {
 
     
     template<typename C, typename ... baseclasses>
-    class MockImpl : private MockObject<C>, public virtual ActualInvocationsSource {
+    class MockImpl : private MockObject<C>, public virtual ActualInvocationsSource, private ListedStatisticsSource {
     public:
 
-        MockImpl(FakeitContext &fakeit, C &obj)
-                : MockImpl<C, baseclasses...>(fakeit, obj, true) {
+        MockImpl(FakeitContext &fakeit, C &obj, RecordingOptions options = RecordingOptions())
+                : MockImpl<C, baseclasses...>(fakeit, obj, true, options) {
         }
 
-        MockImpl(FakeitContext &fakeit)
-                : MockImpl<C, baseclasses...>(fakeit, *(createFakeInstance()), false) {
+        MockImpl(FakeitContext &fakeit, RecordingOptions options = RecordingOptions())
+                : MockImpl<C, baseclasses...>(fakeit, *(createFakeInstance()), false, options) {
             FakeObject<C, baseclasses...> *fake = reinterpret_cast<FakeObject<C, baseclasses...> *>(_instance);
             fake->getVirtualTable().setCookie(1, this);
         }
 
+        /**
+         * A fake with the stubbing of the given mock, shared with it rather than copied.
+         */
+        MockImpl(FakeitContext &fakeit, MockImpl<C, baseclasses...> &stubbingTemplate, RecordingOptions options)
+                : MockImpl<C, baseclasses...>(fakeit, options) {
+            unsigned int *unverifiedInvocations = _options.isThreadSafe ? nullptr : &_unverifiedInvocations;
+            _proxy.bindLike(stubbingTemplate._proxy, [&](Destructible *handler) {
+                return dynamic_cast<StubbingSource *>(handler)->shareStubbing(_options, unverifiedInvocations);
+            });
+        }
+
         virtual ~MockImpl() NO_THROWS {
+            _events->wait();
+            _statistics->remove(*this);
             _proxy.detach();
             if (_isOwner) {
                 FakeObject<C, baseclasses...> *fake = reinterpret_cast<FakeObject<C, baseclasses...> *>(_instance);
@@ -61,8 +74,50 @@ namespace fakeit {
             }
         }
 
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            std::vector<ActualInvocationsSource *> vec;
+            _proxy.getMethodMocks(vec);
+            for (ActualInvocationsSource *s : vec) {
+                s->getActualInvocationRuns(into);
+            }
+        }
+
+        bool hasDroppedInvocations() const override {
+            std::vector<ActualInvocationsSource *> vec;
+            _proxy.getMethodMocks(vec);
+            for (ActualInvocationsSource *s : vec) {
+                if (s->hasDroppedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            std::vector<ActualInvocationsSource *> vec;
+            _proxy.getMethodMocks(vec);
+            for (ActualInvocationsSource *s : vec) {
+                if (s->hasDroppedUnverifiedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            // a mock that doesn't record can't tell, verifying it reports the error.
+            // a ThreadSafe mock doesn't count, that would make all calling threads contend on the counter.
+            return _unverifiedInvocations > 0 || !_options.isRecording || _options.isThreadSafe;
+        }
+
         void reset() {
+            _events->wait();
+            _statistics->retire(*this);
+            std::vector<ReusableMethodBody *> bodies;
+            _proxy.getMethodMocks(bodies);
+            for (ReusableMethodBody *body : bodies) {
+                body->clear();
+            }
             _proxy.Reset();
+            _unverifiedInvocations = 0;
             if (_isOwner) {
                 FakeObject<C, baseclasses...> *fake = reinterpret_cast<FakeObject<C, baseclasses...> *>(_instance);
                 fake->initializeDataMembersArea();
@@ -97,7 +152,27 @@ namespace fakeit {
         DynamicProxy<C, baseclasses...> _proxy;
         C *_instance; //
         bool _isOwner;
+        RecordingOptions _options;
+        unsigned int _unverifiedInvocations; // recorded invocations of all methods that are not verified yet
         FakeitContext &_fakeit;
+        std::shared_ptr<CallStatistics> _statistics;
+        std::shared_ptr<AsyncEventDispatch> _events;
+
+        void collectStatistics(std::vector<NamedStatistics> &into) const override {
+            std::vector<StatisticsSource *> methods;
+            _proxy.getMethodMocks(methods);
+            for (StatisticsSource *method : methods) {
+                method->collectStatistics(into);
+            }
+        }
+
+        void clearStatistics() override {
+            std::vector<StatisticsSource *> methods;
+            _proxy.getMethodMocks(methods);
+            for (StatisticsSource *method : methods) {
+                method->clearStatistics();
+            }
+        }
 
         template<typename R, typename ... arglist>
         class MethodMockingContextBase : public MethodMockingContext<R, arglist...>::Context {
@@ -120,7 +195,31 @@ namespace fakeit {
                 getRecordedMethodBody().scanActualInvocations(scanner);
             }
 
-            void setMethodDetails(std::string mockName, std::string methodName) {
+            unsigned int getInvocationsCount() {
+                return getRecordedMethodBody().getInvocationsCount();
+            }
+
+            bool hasDroppedInvocations() {
+                return getRecordedMethodBody().hasDroppedInvocations();
+            }
+
+            bool hasDroppedUnverifiedInvocations() {
+                return getRecordedMethodBody().hasDroppedUnverifiedInvocations();
+            }
+
+            void markDroppedInvocationsAsVerified() {
+                getRecordedMethodBody().markDroppedInvocationsAsVerified();
+            }
+
+            bool mayHaveUnverifiedInvocations() {
+                return _mock.mayHaveUnverifiedInvocations();
+            }
+
+            void setArgumentsCapture(ArgumentsCapture capture) {
+                getRecordedMethodBody().setArgumentsCapture(capture);
+            }
+
+            void setMethodDetails(InternedString mockName, InternedString methodName) {
                 getRecordedMethodBody().setMethodDetails(mockName, methodName);
             }
 
@@ -132,6 +231,10 @@ namespace fakeit {
                 return _mock;
             }
 
+            TraceReplayTarget &getTraceReplayTarget() {
+                return getRecordedMethodBody();
+            }
+
             std::string getMethodName() {
                 return getRecordedMethodBody().getMethod().name();
             }
@@ -248,7 +351,14 @@ namespace fakeit {
         RecordedMethodBody<R, arglist...> &stubMethodIfNotStubbed(DynamicProxy<C, baseclasses...> &proxy,
                                                                   R (C::*vMethod)(arglist...)) {
             if (!proxy.isMethodStubbed(vMethod)) {
-                proxy.template stubMethod<id>(vMethod, createRecordedMethodBody < R, arglist... > (*this, vMethod));
+                // a body left by reset is bound again.
+                auto body = dynamic_cast<RecordedMethodBody<R, arglist...> *>(proxy.getMethodMock(vMethod));
+                if (!body) {
+                    body = createRecordedMethodBody < R, arglist... > (*this, vMethod, _options);
+                    if (!_options.isThreadSafe)
+                        body->getMethod().setUnverifiedInvocationsCounter(&_unverifiedInvocations);
+                }
+                proxy.template stubMethod<id>(vMethod, body);
             }
             Destructible *d = proxy.getMethodMock(vMethod);
             RecordedMethodBody<R, arglist...> *methodMock = dynamic_cast<RecordedMethodBody<R, arglist...> *>(d);
@@ -257,25 +367,33 @@ namespace fakeit {
 
         RecordedMethodBody<void> &stubDtorIfNotStubbed(DynamicProxy<C, baseclasses...> &proxy) {
             if (!proxy.isDtorStubbed()) {
-                proxy.stubDtor(createRecordedDtorBody(*this));
+                auto body = dynamic_cast<RecordedMethodBody<void> *>(proxy.getDtorMock());
+                if (!body) {
+                    body = createRecordedDtorBody(*this, _options);
+                    if (!_options.isThreadSafe)
+                        body->getMethod().setUnverifiedInvocationsCounter(&_unverifiedInvocations);
+                }
+                proxy.stubDtor(body);
             }
             Destructible *d = proxy.getDtorMock();
             RecordedMethodBody<void> *dtorMock = dynamic_cast<RecordedMethodBody<void> *>(d);
             return *dtorMock;
         }
 
-        MockImpl(FakeitContext &fakeit, C &obj, bool isSpy)
-                : _proxy{obj}, _instance(&obj), _isOwner(!isSpy), _fakeit(fakeit) {
+        MockImpl(FakeitContext &fakeit, C &obj, bool isSpy, RecordingOptions options)
+                : _proxy{obj}, _instance(&obj), _isOwner(!isSpy), _options(options), _unverifiedInvocations(0), _fakeit(fakeit),
+                  _statistics(fakeit.getCallStatistics()), _events(fakeit.getAsyncEventDispatch()) {
+            _statistics->add(*this);
         }
 
         template<typename R, typename ... arglist>
         static RecordedMethodBody<R, arglist...> *createRecordedMethodBody(MockObject<C> &mock,
-                                                                           R(C::*vMethod)(arglist...)) {
-            return new RecordedMethodBody<R, arglist...>(mock.getFakeIt(), typeid(vMethod).name());
+                                                                           R(C::*vMethod)(arglist...), RecordingOptions options) {
+            return new RecordedMethodBody<R, arglist...>(mock.getFakeIt(), typeid(vMethod).name(), options);
         }
 
-        static RecordedMethodBody<void> *createRecordedDtorBody(MockObject<C> &mock) {
-            return new RecordedMethodBody<void>(mock.getFakeIt(), "dtor");
+        static RecordedMethodBody<void> *createRecordedDtorBody(MockObject<C> &mock, RecordingOptions options) {
+            return new RecordedMethodBody<void>(mock.getFakeIt(), "dtor", options);
         }
 
     };
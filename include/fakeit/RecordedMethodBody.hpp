@@ -10,23 +10,64 @@
 #include <vector>
 #include <functional>
 #include <tuple>
+#include <memory>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 
+#include "mockutils/Macros.hpp"
 #include "mockutils/TupleDispatcher.hpp"
+#include "mockutils/TupleHash.hpp"
 #include "fakeit/DomainObjects.hpp"
 #include "fakeit/ActualInvocation.hpp"
 #include "fakeit/ActualInvocationHandler.hpp"
 #include "fakeit/invocation_matchers.hpp"
 #include "fakeit/FakeitEvents.hpp"
 #include "fakeit/FakeitExceptions.hpp"
+#include "fakeit/MethodStatistics.hpp"
+#include "fakeit/InvocationTrace.hpp"
 #include "mockutils/MethodInvocationHandler.hpp"
+#include "mockutils/Arena.hpp"
+#include "mockutils/Finally.hpp"
 
 namespace fakeit {
 
+    /**
+     * A method body that the body of the same method in another mock can be started from.
+     */
+    struct StubbingSource {
+
+        virtual ~StubbingSource() = default;
+
+        /**
+         * A new body of the same method, sharing the stubbing of this one and recording its own invocations.
+         * Its unverified invocations are counted in the given counter, if any.
+         */
+        virtual Destructible *shareStubbing(RecordingOptions options, unsigned int *unverifiedInvocationsCounter) = 0;
+    };
+
+    /**
+     * A method body that a reset mock empties and keeps, rather than destroying it.
+     */
+    struct ReusableMethodBody {
+
+        virtual ~ReusableMethodBody() = default;
+
+        /**
+         * Forget the stubbing and the recorded invocations, keeping the storage they had.
+         * The unverified invocations are not uncounted one by one: the mock resets its count as a whole.
+         */
+        virtual void clear() = 0;
+    };
+
 /**
  * A composite MethodInvocationHandler that holds a list of ActionSequence objects.
  */
     template<typename R, typename ... arglist>
-    class RecordedMethodBody : public MethodInvocationHandler<R, arglist...>, public ActualInvocationsSource {
+    class RecordedMethodBody : public MethodInvocationHandler<R, arglist...>, public ActualInvocationsSource,
+                               public StubbingSource, public ReusableMethodBody, public StatisticsSource,
+                               public TraceReplayTarget {
 
         struct MatchedInvocationHandler : ActualInvocationHandler<R, arglist...> {
 
@@ -39,28 +80,113 @@ namespace fakeit {
 
             virtual R handleMethodInvocation(ArgumentsTuple<arglist...> & args) override
             {
-                Destructible &destructable = *_invocationHandler;
-                ActualInvocationHandler<R, arglist...> &invocationHandler = dynamic_cast<ActualInvocationHandler<R, arglist...> &>(destructable);
-                return invocationHandler.handleMethodInvocation(args);
+                return _invocationHandler->handleMethodInvocation(args);
+            }
+
+            virtual ActualInvocationHandler<R, arglist...> *forkProgress() override {
+                return _invocationHandler->forkProgress();
             }
 
             typename ActualInvocation<arglist...>::Matcher &getMatcher() const {
-                Destructible &destructable = *_matcher;
-                typename ActualInvocation<arglist...>::Matcher &matcher = dynamic_cast<typename ActualInvocation<arglist...>::Matcher &>(destructable);
-                return matcher;
+                return *_matcher;
             }
 
         private:
-            std::shared_ptr<Destructible> _matcher;
-            std::shared_ptr<Destructible> _invocationHandler;
+            std::unique_ptr<typename ActualInvocation<arglist...>::Matcher> _matcher;
+            std::unique_ptr<ActualInvocationHandler<R, arglist...>> _invocationHandler;
         };
 
 
+        typedef Arena<ActualInvocation<arglist...>> InvocationLog;
+
+        /**
+         * The invocations recorded by one thread of a ThreadSafe mock.
+         */
+        struct ThreadLog {
+            explicit ThreadLog(std::thread::id aThread) : thread(aThread), next(nullptr) { }
+
+            std::thread::id thread;
+            InvocationLog invocations;
+            ThreadLog *next;
+        };
+
         FakeitContext &_fakeit;
         MethodInfo _method;
+        RecordingOptions _options;
+        ArgumentsCapture _argumentsCapture;
+        unsigned int _droppedInvocations;
+        unsigned int _droppedUnverifiedInvocations;
+        unsigned int _dispatchDepth;
+        CallCounters _counters;
+        InvocationTraceWriter *_tracedIn; // the trace this method was declared in, if any
+
+        /**
+         * Handlers registered for the method, on top of the ones of a base stubbing registered before them.
+         * A stubbing is shared by the bodies of mocks created from the same template and is never changed
+         * once shared: adding a handler to a shared stubbing layers a new one on top of it.
+         */
+        struct Stubbing {
+            // Handlers are kept with their concrete types, so no RTTI is needed on the call path.
+            std::vector<std::unique_ptr<MatchedInvocationHandler>> handlers;
+
+            // Handlers whose matchers only match arguments equal to fixed values are indexed by the hash of
+            // these values, so finding them takes no scan. Both refer to positions in handlers.
+            std::unordered_multimap<size_t, size_t> indexedHandlers;
+            std::vector<size_t> unindexedHandlers; // in registration order
+
+            std::shared_ptr<Stubbing> base;
+
+            /**
+             * The last registered handler of this layer that matches the invocation.
+             */
+            MatchedInvocationHandler *find(ActualInvocation<arglist...> &invocation) {
+                bool found = false;
+                size_t last = 0;
+                if (!indexedHandlers.empty()) {
+                    auto candidates = indexedHandlers.equal_range(
+                            hashArguments(invocation.getActualArguments(), AreArgumentsHashable()));
+                    for (auto i = candidates.first; i != candidates.second; ++i) {
+                        if ((!found || i->second > last) && handlers[i->second]->getMatcher().matches(invocation)) {
+                            found = true;
+                            last = i->second;
+                        }
+                    }
+                }
+                // only handlers registered after the indexed match can override it.
+                for (auto i = unindexedHandlers.rbegin(); i != unindexedHandlers.rend() && (!found || *i > last); ++i) {
+                    if (handlers[*i]->getMatcher().matches(invocation)) {
+                        return handlers[*i].get();
+                    }
+                }
+                return found ? handlers[last].get() : nullptr;
+            }
+        };
+
+        // Null until the method is stubbed.
+        std::shared_ptr<Stubbing> _stubbing;
+
+        // The handlers of a stubbing shared with a template that keep their own progress for this mock, so a
+        // sequence like Return(1, 2) starts over for every mock. Filled when the body is created and only read
+        // after that, so calls from several threads don't need a lock.
+        std::unordered_map<const MatchedInvocationHandler *, std::unique_ptr<ActualInvocationHandler<R, arglist...>>>
+                _forkedHandlers;
 
-        std::vector<std::shared_ptr<Destructible>> _invocationHandlers;
-        std::vector<std::shared_ptr<Destructible>> _actualInvocations;
+        typedef all_true<is_trace_serializable<typename naked_type<arglist>::type>::value...> AreArgumentsTraceable;
+        // not instantiated for arguments that can't be traced, which may not even be storable (abstract types).
+        typedef typename std::conditional<AreArgumentsTraceable::value,
+                std::tuple<typename naked_type<arglist>::type...>, std::tuple<>>::type TracedValues;
+        typedef all_true<!std::is_reference<arglist>::value...> AreArgumentsValues;
+
+        // The arguments of replayed invocations that take them by reference. Declared before the logs, whose
+        // invocations refer to them.
+        Arena<TracedValues> _replayedValues;
+
+        // Invocations are recorded in place in an arena: no allocation per call and bulk release on reset.
+        InvocationLog _actualInvocations;
+
+        // A ThreadSafe mock records in per thread logs instead of _actualInvocations. Logs are only ever
+        // prepended, with a CAS, and are kept until the body is destroyed.
+        std::atomic<ThreadLog *> _threadLogs;
 
         MatchedInvocationHandler *buildMatchedInvocationHandler(
                 typename ActualInvocation<arglist...>::Matcher *invocationMatcher,
@@ -68,37 +194,291 @@ namespace fakeit {
             return new MatchedInvocationHandler(invocationMatcher, invocationHandler);
         }
 
-        MatchedInvocationHandler *getInvocationHandlerForActualArgs(ActualInvocation<arglist...> &invocation) {
-            for (auto i = _invocationHandlers.rbegin(); i != _invocationHandlers.rend(); ++i) {
-                std::shared_ptr<Destructible> curr = *i;
-                Destructible &destructable = *curr;
-                MatchedInvocationHandler &im = asMatchedInvocationHandler(destructable);
-                if (im.getMatcher().matches(invocation)) {
-                    return &im;
+        UnexpectedMethodCallException unexpectedMethodCall(ActualInvocation<arglist...> &actualInvocation) {
+            _counters.countUnmatchedCall();
+            UnexpectedMethodCallEvent event(UnexpectedType::Unmatched, actualInvocation);
+            _fakeit.handle(event);
+            std::string format{_fakeit.format(event)};
+            return UnexpectedMethodCallException(format);
+        }
+
+        R dispatch(ActualInvocation<arglist...> &actualInvocation, InvocationLog *recordedIn) {
+            MatchedInvocationHandler *invocationHandler;
+            {
+                CallTimer matching(_counters, &CallCounters::addMatchingTime);
+                invocationHandler = getInvocationHandlerForActualArgs(actualInvocation);
+            }
+            if (!invocationHandler) {
+                // unmatched invocations are not recorded.
+                Finally discardInvocation([&]() {
+                    if (recordedIn) {
+                        _method.removeUnverifiedInvocation();
+                        recordedIn->erase(&actualInvocation);
+                    }
+                });
+                throw unexpectedMethodCall(actualInvocation);
+            }
+
+            auto &matcher = invocationHandler->getMatcher();
+            actualInvocation.setActualMatcher(&matcher);
+            if (_options.trace)
+                trace(actualInvocation);
+            Finally releaseArguments([&]() {
+                if (recordedIn) {
+                    release(actualInvocation);
+                    _counters.addCapturedArgumentBytes(capturedArgumentBytes());
                 }
+            });
+            ActualInvocationHandler<R, arglist...> *handler = invocationHandler;
+            if (!_forkedHandlers.empty()) {
+                auto fork = _forkedHandlers.find(invocationHandler);
+                if (fork != _forkedHandlers.end())
+                    handler = fork->second.get();
             }
-            return nullptr;
+            try {
+                CallTimer action(_counters, &CallCounters::addActionTime);
+                return handler->handleMethodInvocation(actualInvocation.getActualArguments());
+            } catch (NoMoreRecordedActionException &) {
+            }
+            throw unexpectedMethodCall(actualInvocation);
+        }
+
+        /**
+         * Drop the oldest invocations beyond the history limit.
+         * Only done once no call to this method is in progress, since an action may still use the arguments
+         * of its invocation.
+         */
+        void trimHistory() {
+            while (_actualInvocations.size() > _options.historyLimit) {
+                if (!_actualInvocations.front().isVerified()) {
+                    _method.removeUnverifiedInvocation();
+                    _droppedUnverifiedInvocations++;
+                }
+                _actualInvocations.pop_front();
+                _droppedInvocations++;
+            }
+        }
+
+        R dispatchWithBoundedHistory(ActualInvocation<arglist...> &actualInvocation) {
+            _dispatchDepth++;
+            Finally trim([&]() {
+                if (--_dispatchDepth == 0)
+                    trimHistory();
+            });
+            return dispatch(actualInvocation, &_actualInvocations);
+        }
+
+        /**
+         * The log of the calling thread, created on its first call.
+         * Only the owning thread appends to a log, so recording needs no lock.
+         */
+        InvocationLog &getThreadLog() {
+            // a small per thread cache of recently used logs. Method ids are never reused, so an entry
+            // left by a destroyed body is never mistaken for one of this body.
+            struct CachedLog {
+                unsigned int methodId;
+                InvocationLog *log;
+            };
+            static THREAD_LOCAL CachedLog cache[16];
+            CachedLog &cached = cache[_method.id() % 16];
+            if (cached.methodId == _method.id())
+                return *cached.log;
+
+            std::thread::id self = std::this_thread::get_id();
+            ThreadLog *threadLog = _threadLogs.load(std::memory_order_acquire);
+            while (threadLog && threadLog->thread != self)
+                threadLog = threadLog->next;
+            if (!threadLog) {
+                threadLog = new ThreadLog(self);
+                threadLog->next = _threadLogs.load(std::memory_order_relaxed);
+                while (!_threadLogs.compare_exchange_weak(threadLog->next, threadLog, std::memory_order_release,
+                                                          std::memory_order_relaxed)) {
+                }
+            }
+            cached.methodId = _method.id();
+            cached.log = &threadLog->invocations;
+            return threadLog->invocations;
+        }
+
+        /**
+         * The log a new invocation is recorded in: the one of the calling thread for a ThreadSafe mock.
+         */
+        InvocationLog &getRecordingLog() {
+            return _options.isThreadSafe ? getThreadLog() : _actualInvocations;
+        }
+
+        template<typename F>
+        void forEachLog(F f) {
+            f(_actualInvocations);
+            for (ThreadLog *threadLog = _threadLogs.load(std::memory_order_acquire); threadLog; threadLog = threadLog->next)
+                f(threadLog->invocations);
+        }
+
+        template<typename F>
+        void forEachLog(F f) const {
+            const_cast<RecordedMethodBody *>(this)->forEachLog([&](const InvocationLog &log) {
+                f(log);
+            });
+        }
+
+        void assertRecording() const {
+            if (_options.trace) {
+                throw std::invalid_argument(std::string("can't verify ").append(_method.name())
+                                                    .append(": the mock was created with TraceTo, replay its trace"));
+            }
+            if (!_options.isRecording) {
+                throw std::invalid_argument(
+                        std::string("can't verify ").append(_method.name()).append(": the mock was created with NoRecording"));
+            }
+        }
+
+        typedef all_true<is_hashable<typename naked_type<arglist>::type>::value...> AreArgumentsHashable;
+
+        static size_t hashArguments(ArgumentsTuple<arglist...> &arguments, std::true_type) {
+            return TupleHash<ArgumentsTuple<arglist...>, sizeof...(arglist)>::hash(arguments);
+        }
+
+        static size_t hashArguments(ArgumentsTuple<arglist...> &, std::false_type) {
+            return 0; // no matcher of such arguments is indexed.
+        }
+
+        /**
+         * Release the arguments of a recorded invocation whose call is over, as the capture of this method asks.
+         */
+        void release(ActualInvocation<arglist...> &invocation) {
+            if (_argumentsCapture == ArgumentsCapture::ByValue)
+                return;
+            size_t fingerprint = _argumentsCapture == ArgumentsCapture::ByFingerprint ?
+                    hashArguments(invocation.getActualArguments(), AreArgumentsHashable()) : 0;
+            invocation.releaseArguments(_argumentsCapture, fingerprint);
+        }
+
+        /**
+         * What a recorded invocation keeps of its arguments once released. Memory the arguments refer to
+         * is not included.
+         */
+        size_t capturedArgumentBytes() const {
+            switch (_argumentsCapture) {
+                case ArgumentsCapture::ByValue:
+                    return sizeof(ArgumentsTuple<arglist...>);
+                case ArgumentsCapture::ByFingerprint:
+                    return sizeof(size_t);
+                default:
+                    return 0;
+            }
+        }
+
+        /**
+         * What the trace keeps of the arguments: as much as the capture of the method asks for and their types allow.
+         */
+        TracedArguments tracedArguments() const {
+            if (_argumentsCapture == ArgumentsCapture::ByValue && AreArgumentsTraceable::value)
+                return TracedArguments::Values;
+            if (_argumentsCapture != ArgumentsCapture::ByReference && AreArgumentsHashable::value)
+                return TracedArguments::Fingerprint;
+            return TracedArguments::None;
+        }
+
+        static void writeTracedValues(TraceOutput &out, ArgumentsTuple<arglist...> &arguments, std::true_type) {
+            TupleTraceWriter<ArgumentsTuple<arglist...>, sizeof...(arglist)>::write(out, arguments);
+        }
+
+        static void writeTracedValues(TraceOutput &, ArgumentsTuple<arglist...> &, std::false_type) {
+        }
+
+        void trace(ActualInvocation<arglist...> &invocation) {
+            InvocationTraceWriter &writer = *_options.trace;
+            if (_tracedIn != &writer) {
+                writer.declareMethod(_method, getTraceSignature());
+                _tracedIn = &writer;
+            }
+            TracedArguments encoding = tracedArguments();
+            writer.appendInvocation(_method.id(), invocation.getOrdinal(), encoding, [&](TraceOutput &out) {
+                if (encoding == TracedArguments::Values) {
+                    writeTracedValues(out, invocation.getActualArguments(), AreArgumentsTraceable());
+                } else if (encoding == TracedArguments::Fingerprint) {
+                    uint64_t fingerprint = hashArguments(invocation.getActualArguments(), AreArgumentsHashable());
+                    out.write(&fingerprint, sizeof(fingerprint));
+                }
+            });
+        }
+
+        template<std::size_t... indices>
+        ActualInvocation<arglist...> *replayValues(InvocationLog &log, unsigned int ordinal, TracedValues &values,
+                                                   tuple_indices<indices...>) {
+            return log.emplace_back(ordinal, _method, static_cast<
+                    typename fakeit::production_arg<arglist>::type>(std::get<indices>(values))...);
+        }
+
+        // the values are moved into the invocation.
+        ActualInvocation<arglist...> *replayValues(InvocationLog &log, unsigned int ordinal, TracedValues &&values,
+                                                   std::true_type) {
+            return replayValues(log, ordinal, values, typename make_tuple_indices<sizeof...(arglist)>::type());
         }
 
-        MatchedInvocationHandler &asMatchedInvocationHandler(Destructible &destructable) {
-            MatchedInvocationHandler &im = dynamic_cast<MatchedInvocationHandler &>(destructable);
-            return im;
+        // the invocation refers to the values, which are kept as long as it is.
+        ActualInvocation<arglist...> *replayValues(InvocationLog &log, unsigned int ordinal, TracedValues &&values,
+                                                   std::false_type) {
+            TracedValues *kept = _replayedValues.emplace_back(std::move(values));
+            return replayValues(log, ordinal, *kept, typename make_tuple_indices<sizeof...(arglist)>::type());
         }
 
-        ActualInvocation<arglist...> &asActualInvocation(Destructible &destructable) const {
-            ActualInvocation<arglist...> &invocation = dynamic_cast<ActualInvocation<arglist...> &>(destructable);
-            return invocation;
+        ActualInvocation<arglist...> *replayValues(InvocationLog &log, unsigned int ordinal, TraceInput &in,
+                                                   std::true_type) {
+            // braced initialization reads the values in order.
+            return replayValues(log, ordinal,
+                                TracedValues{TraceCodec<typename naked_type<arglist>::type>::read(in)...},
+                                AreArgumentsValues());
+        }
+
+        ActualInvocation<arglist...> *replayValues(InvocationLog &, unsigned int, TraceInput &, std::false_type) {
+            throw std::runtime_error(std::string("can't replay the arguments of ").append(_method.name())
+                                             .append(": they have no TraceCodec in this build"));
+        }
+
+        /**
+         * The last registered handler that matches the invocation. Layers are searched from the newest one.
+         */
+        MatchedInvocationHandler *getInvocationHandlerForActualArgs(ActualInvocation<arglist...> &invocation) {
+            for (Stubbing *stubbing = _stubbing.get(); stubbing; stubbing = stubbing->base.get()) {
+                MatchedInvocationHandler *handler = stubbing->find(invocation);
+                if (handler)
+                    return handler;
+            }
+            return nullptr;
+        }
+
+        RecordedMethodBody(RecordedMethodBody &stubbingSource, RecordingOptions options) :
+                _fakeit(stubbingSource._fakeit), _method{MethodInfo::nextMethodOrdinal(), stubbingSource._method},
+                _options(options), _argumentsCapture(stubbingSource._argumentsCapture), _droppedInvocations(0),
+                _droppedUnverifiedInvocations(0), _dispatchDepth(0), _counters(options.isThreadSafe), _tracedIn(nullptr),
+                _stubbing(stubbingSource._stubbing), _threadLogs(nullptr) {
+            for (Stubbing *stubbing = _stubbing.get(); stubbing; stubbing = stubbing->base.get()) {
+                for (auto &handler : stubbing->handlers) {
+                    ActualInvocationHandler<R, arglist...> *fork = handler->forkProgress();
+                    if (fork)
+                        _forkedHandlers[handler.get()].reset(fork);
+                }
+            }
         }
 
     public:
 
-        RecordedMethodBody(FakeitContext &fakeit, std::string name) :
-                _fakeit(fakeit), _method{MethodInfo::nextMethodOrdinal(), name} { }
+        RecordedMethodBody(FakeitContext &fakeit, InternedString name, RecordingOptions options = RecordingOptions()) :
+                _fakeit(fakeit), _method{MethodInfo::nextMethodOrdinal(), std::move(name)}, _options(options),
+                _argumentsCapture(ArgumentsCapture::ByValue), _droppedInvocations(0), _droppedUnverifiedInvocations(0),
+                _dispatchDepth(0), _counters(options.isThreadSafe), _tracedIn(nullptr), _threadLogs(nullptr) { }
 
         virtual ~RecordedMethodBody() NO_THROWS {
+            ThreadLog *threadLog = _threadLogs.load();
+            while (threadLog) {
+                ThreadLog *next = threadLog->next;
+                delete threadLog;
+                threadLog = next;
+            }
         }
 
-        MethodInfo &getMethod() {
+        MethodInfo &getMethod() override {
             return _method;
         }
 
@@ -107,62 +487,189 @@ namespace fakeit {
             return method.id() == _method.id();
         }
 
+        /**
+         * Applies to the invocations recorded from now on.
+         */
+        void setArgumentsCapture(ArgumentsCapture capture) {
+            if (capture == ArgumentsCapture::ByFingerprint && !AreArgumentsHashable::value) {
+                throw std::invalid_argument(std::string("can't capture fingerprints of the arguments of ")
+                                                    .append(_method.name()).append(": not all of them have a std::hash"));
+            }
+            _argumentsCapture = capture;
+        }
+
         void addMethodInvocationHandler(typename ActualInvocation<arglist...>::Matcher *matcher,
             ActualInvocationHandler<R, arglist...> *invocationHandler) {
-            ActualInvocationHandler<R, arglist...> *mock = buildMatchedInvocationHandler(matcher, invocationHandler);
-            std::shared_ptr<Destructible> destructable{mock};
-            _invocationHandlers.push_back(destructable);
+            if (!_stubbing || _stubbing.use_count() > 1) {
+                std::shared_ptr<Stubbing> layer = std::make_shared<Stubbing>();
+                layer->base = std::move(_stubbing);
+                _stubbing = std::move(layer);
+            }
+            size_t position = _stubbing->handlers.size();
+            _stubbing->handlers.emplace_back(buildMatchedInvocationHandler(matcher, invocationHandler));
+            size_t hash;
+            if (matcher->getExpectedArgumentsHash(hash)) {
+                _stubbing->indexedHandlers.emplace(hash, position);
+            } else {
+                _stubbing->unindexedHandlers.push_back(position);
+            }
+        }
+
+        Destructible *shareStubbing(RecordingOptions options, unsigned int *unverifiedInvocationsCounter) override {
+            RecordedMethodBody *body = new RecordedMethodBody(*this, options);
+            body->_method.setUnverifiedInvocationsCounter(unverifiedInvocationsCounter);
+            return body;
+        }
+
+        void clear() override {
+            _forkedHandlers.clear();
+            if (_stubbing.use_count() == 1) {
+                _stubbing->handlers.clear();
+                _stubbing->indexedHandlers.clear();
+                _stubbing->unindexedHandlers.clear();
+                _stubbing->base.reset();
+            } else {
+                _stubbing.reset();
+            }
+            forEachLog([](InvocationLog &log) {
+                log.clear();
+            });
+            _replayedValues.clear();
+            _argumentsCapture = ArgumentsCapture::ByValue;
+            _droppedInvocations = 0;
+            _droppedUnverifiedInvocations = 0;
+            _counters.clear();
+        }
+
+        void collectStatistics(std::vector<NamedStatistics> &into) const override {
+            if (_counters.isEmpty())
+                return;
+            into.emplace_back();
+            into.back().mockName = _method.mockName();
+            into.back().methodName = _method.methodName();
+            _counters.snapshot(into.back().statistics);
         }
 
-        void clear() {
-            _invocationHandlers.clear();
-            _actualInvocations.clear();
+        void clearStatistics() override {
+            _counters.clear();
         }
 
 
         R handleMethodInvocation(const typename fakeit::production_arg<arglist>::type... args) override {
             unsigned int ordinal = Invocation::nextInvocationOrdinal();
             MethodInfo &method = this->getMethod();
-            auto actualInvocation = new ActualInvocation<arglist...>(ordinal, method, std::forward<const typename fakeit::production_arg<arglist>::type>(args)...);
-
-            // ensure deletion if not added to actual invocations.
-            std::shared_ptr<Destructible> actualInvocationDtor{actualInvocation};
-
-            auto invocationHandler = getInvocationHandlerForActualArgs(*actualInvocation);
-            if (invocationHandler) {
-                auto &matcher = invocationHandler->getMatcher();
-                actualInvocation->setActualMatcher(&matcher);
-                _actualInvocations.push_back(actualInvocationDtor);
-                try {
-                    return invocationHandler->handleMethodInvocation(actualInvocation->getActualArguments());
-                } catch (NoMoreRecordedActionException &) {
-                }
+            _counters.countCall();
+            if (!_options.isRecording) {
+                ActualInvocation<arglist...> actualInvocation(
+                        ordinal, method, std::forward<const typename fakeit::production_arg<arglist>::type>(args)...);
+                return dispatch(actualInvocation, nullptr);
             }
-
-            UnexpectedMethodCallEvent event(UnexpectedType::Unmatched, *actualInvocation);
-            _fakeit.handle(event);
-            std::string format{_fakeit.format(event)};
-            UnexpectedMethodCallException e(format);
-            throw e;
+            InvocationLog &log = getRecordingLog();
+            ActualInvocation<arglist...> *actualInvocation = log.emplace_back(
+                    ordinal, method, std::forward<const typename fakeit::production_arg<arglist>::type>(args)...);
+            if (_options.isThreadSafe) {
+                return dispatch(*actualInvocation, &log);
+            }
+            method.addUnverifiedInvocation();
+            if (_options.historyLimit > 0) {
+                return dispatchWithBoundedHistory(*actualInvocation);
+            }
+            return dispatch(*actualInvocation, &_actualInvocations);
         }
 
         void scanActualInvocations(const std::function<void(ActualInvocation<arglist...> &)> &scanner) {
-            for (auto destructablePtr : _actualInvocations) {
-                ActualInvocation<arglist...> &invocation = asActualInvocation(*destructablePtr);
-                scanner(invocation);
-            }
+            assertRecording();
+            forEachLog([&](InvocationLog &log) {
+                log.forEach(scanner);
+            });
         }
 
         void getActualInvocations(std::unordered_set<Invocation *> &into) const override {
-            for (auto destructablePtr : _actualInvocations) {
-                Invocation &invocation = asActualInvocation(*destructablePtr);
-                into.insert(&invocation);
+            assertRecording();
+            forEachLog([&](const InvocationLog &log) {
+                log.forEach([&](ActualInvocation<arglist...> &invocation) {
+                    into.insert(&invocation);
+                });
+            });
+        }
+
+        /**
+         * Each log is in invocation order, so every log is a run.
+         */
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            assertRecording();
+            forEachLog([&](const InvocationLog &log) {
+                if (log.size() == 0)
+                    return;
+                into.emplace_back();
+                std::vector<Invocation *> &run = into.back();
+                run.reserve(log.size());
+                log.forEach([&](ActualInvocation<arglist...> &invocation) {
+                    run.push_back(&invocation);
+                });
+            });
+        }
+
+        bool hasDroppedInvocations() const override {
+            return _droppedInvocations > 0;
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            return _droppedUnverifiedInvocations > 0;
+        }
+
+        /**
+         * Called when a verification counted all the invocations of the method, the dropped ones included.
+         */
+        void markDroppedInvocationsAsVerified() {
+            _droppedUnverifiedInvocations = 0;
+        }
+
+        const char *getTraceSignature() const override {
+            return typeid(R(arglist...)).name();
+        }
+
+        /**
+         * Record an invocation read from a trace, as if it was made to this method now: it is counted, recorded
+         * in the log a call would be and trimmed to the history limit like one, and gets a fresh ordinal.
+         */
+        void replayInvocation(TracedArguments encoding, TraceInput &arguments) override {
+            assertRecording();
+            unsigned int ordinal = Invocation::nextInvocationOrdinal();
+            _counters.countCall();
+            InvocationLog &log = getRecordingLog();
+            if (encoding == TracedArguments::Values) {
+                replayValues(log, ordinal, arguments, AreArgumentsTraceable());
+            } else if (encoding == TracedArguments::Fingerprint) {
+                uint64_t fingerprint;
+                arguments.read(&fingerprint, sizeof(fingerprint));
+                log.emplace_back(ordinal, _method, ArgumentsCapture::ByFingerprint, (size_t) fingerprint,
+                                 typename ActualInvocation<arglist...>::NoArguments());
+            } else {
+                log.emplace_back(ordinal, _method, ArgumentsCapture::ByReference, 0,
+                                 typename ActualInvocation<arglist...>::NoArguments());
             }
+            if (_options.isThreadSafe)
+                return;
+            _method.addUnverifiedInvocation();
+            if (_options.historyLimit > 0 && _dispatchDepth == 0)
+                trimHistory();
+        }
+
+        /**
+         * The number of recorded invocations, including the ones dropped from a bounded history.
+         */
+        unsigned int getInvocationsCount() const {
+            assertRecording();
+            size_t count = _droppedInvocations;
+            forEachLog([&](const InvocationLog &log) {
+                count += log.size();
+            });
+            return (unsigned int) count;
         }
 
-        void setMethodDetails(const std::string &mockName, const std::string &methodName) {
-            const std::string fullName{mockName + "." + methodName};
-            _method.setName(fullName);
+        void setMethodDetails(InternedString mockName, InternedString methodName) {
+            _method.setName(std::move(mockName), std::move(methodName));
         }
 
     };
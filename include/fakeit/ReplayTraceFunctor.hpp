@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <vector>
+
+#include "fakeit/InvocationTrace.hpp"
+#include "fakeit/MethodMockingContext.hpp"
+
+namespace fakeit {
+
+    /**
+     * ReplayTrace(reader, Method(mock,foo), Method(mock,bar), ...) reads the rest of a trace into the given
+     * methods, which can then be verified as if the traced calls were made to them. A traced method is replayed
+     * into the given method of the same name and signature, preferably of a mock of the same name. Invocations
+     * of the other methods are skipped, so only the verified methods hold their invocations in memory.
+     * Returns the number of invocations replayed.
+     */
+    class ReplayTraceFunctor {
+    public:
+
+        template<typename ... methods>
+        size_t operator()(InvocationTraceReader &reader, const methods &... method) {
+            std::vector<TraceReplayTarget *> targets{&method.getTraceReplayTarget()...};
+            return reader.replayInto(targets);
+        }
+    };
+
+}
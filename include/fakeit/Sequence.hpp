@@ -42,6 +42,21 @@ namespace fakeit {
 
         virtual unsigned int size() const = 0;
 
+        /**
+         * Count the invocations that match this sequence using invocation counters, which also cover
+         * invocations dropped from a bounded history. Returns false if no counter applies.
+         */
+        virtual bool countInvocations(unsigned int &) const {
+            return false;
+        }
+
+        /**
+         * Called when a verification passed on the count of countInvocations, which covered the dropped
+         * invocations too.
+         */
+        virtual void markDroppedInvocationsAsVerified() const {
+        }
+
         friend class VerifyFunctor;
     };
 
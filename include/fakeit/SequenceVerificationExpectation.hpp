@@ -1,6 +1,10 @@
 #pragma once
 
+#include <stdexcept>
+
 #include "mockutils/smart_ptr.hpp"
+#include "mockutils/InternedString.hpp"
+#include "mockutils/to_string.hpp"
 #include "fakeit/FakeitExceptions.hpp"
 #include "fakeit/FakeitContext.hpp"
 #include "fakeit/SortInvocations.hpp"
@@ -27,7 +31,7 @@ namespace fakeit {
             _expectedCount = count;
         }
 
-        void setFileInfo(std::string file, int line, std::string callingMethod) {
+        void setFileInfo(InternedString file, int line, InternedString callingMethod) {
             _file = file;
             _line = line;
             _testMethod = callingMethod;
@@ -40,10 +44,14 @@ namespace fakeit {
         std::vector<Sequence *> _expectedPattern;
         int _expectedCount;
 
-        std::string _file;
+        InternedString _file;
         int _line;
-        std::string _testMethod;
+        InternedString _testMethod;
         bool _isVerified;
+        bool _isPassed;
+        std::string _usageError; // why the expectation can't be verified, if it can't
+        std::vector<Invocation *> _actualSequence;
+        int _actualCount;
 
         SequenceVerificationExpectation(
                 VerificationEventHandler &fakeit,
@@ -54,27 +62,54 @@ namespace fakeit {
                 _expectedPattern(expectedPattern), //
                 _expectedCount(-1), // AT_LEAST_ONCE
                 _line(0),
-                _isVerified(false) {
+                _isVerified(false),
+                _isPassed(false),
+                _actualCount(0) {
         }
 
 
         void VerifyExpectation(VerificationEventHandler &verificationErrorHandler) {
             if (_isVerified)
                 return;
+            if (!Check())
+                reportFailure(verificationErrorHandler);
+        }
+
+        /**
+         * Verify once and tell whether the expectation passed, without reporting a failure.
+         * A failure keeps only what its event needs; the event itself is built by reportFailure.
+         */
+        bool Check() {
+            if (_isVerified) {
+                if (!_usageError.empty())
+                    throw std::invalid_argument(_usageError);
+                return _isPassed;
+            }
             _isVerified = true;
 
             MatchAnalysis ma;
             ma.run(_involvedInvocationSources, _expectedPattern);
 
-            if (isAtLeastVerification() && atLeastLimitNotReached(ma.count)) {
-                return handleAtLeastVerificationEvent(verificationErrorHandler, ma.actualSequence, ma.count);
-            }
+            bool isCounted = _involvedInvocationSources.hasDroppedInvocations() && countDroppedInvocations(ma);
 
-            if (isExactVerification() && exactLimitNotMatched(ma.count)) {
-                return handleExactVerificationEvent(verificationErrorHandler, ma.actualSequence, ma.count);
+            _actualCount = ma.count;
+            if ((isAtLeastVerification() && atLeastLimitNotReached(ma.count)) ||
+                (isExactVerification() && exactLimitNotMatched(ma.count))) {
+                _actualSequence = std::move(ma.actualSequence);
+                return _isPassed = false;
             }
 
             markAsVerified(ma.matchedInvocations);
+            if (isCounted)
+                _expectedPattern[0]->markDroppedInvocationsAsVerified();
+            return _isPassed = true;
+        }
+
+        void reportFailure(VerificationEventHandler &verificationErrorHandler) {
+            if (isAtLeastVerification()) {
+                return handleAtLeastVerificationEvent(verificationErrorHandler, _actualSequence, _actualCount);
+            }
+            return handleExactVerificationEvent(verificationErrorHandler, _actualSequence, _actualCount);
         }
 
         std::vector<Sequence *> &collectSequences(std::vector<Sequence *> &vec) {
@@ -89,6 +124,29 @@ namespace fakeit {
         }
 
 
+        /**
+         * Some involved invocations were dropped from a bounded history (see KeepLast).
+         * A single method pattern is counted from the invocation counters. Any other pattern is verified on the
+         * retained invocations, but only if they are enough to decide the result.
+         * Returns true if the count covers the dropped invocations.
+         */
+        bool countDroppedInvocations(MatchAnalysis &ma) {
+            unsigned int count;
+            if (_expectedPattern.size() == 1 && _expectedPattern[0]->countInvocations(count)) {
+                ma.count = (int) count;
+                return true;
+            }
+
+            bool isDecided = isAtLeastVerification() ? !atLeastLimitNotReached(ma.count) : ma.count > _expectedCount;
+            if (!isDecided) {
+                std::string location = _file.empty() ? "" : " at " + _file.str() + ":" + fakeit::to_string(_line);
+                _usageError = "can't verify" + location + ": the expected pattern may match invocations that were "
+                        "dropped from a KeepLast invocation history";
+                throw std::invalid_argument(_usageError);
+            }
+            return false;
+        }
+
         static void markAsVerified(std::vector<Invocation *> &matchedInvocations) {
             for (auto i : matchedInvocations) {
                 i->markAsVerified();
@@ -113,18 +171,18 @@ namespace fakeit {
         }
 
         void handleExactVerificationEvent(VerificationEventHandler &verificationErrorHandler,
-                                          std::vector<Invocation *> actualSequence, int count) {
+                                          std::vector<Invocation *> &actualSequence, int count) {
             SequenceVerificationEvent evt(VerificationType::Exact, _expectedPattern, actualSequence, _expectedCount,
                                           count);
-            evt.setFileInfo(_file, _line, _testMethod);
+            evt.setFileInfo(_file.str(), _line, _testMethod.str());
             return verificationErrorHandler.handle(evt);
         }
 
         void handleAtLeastVerificationEvent(VerificationEventHandler &verificationErrorHandler,
-                                            std::vector<Invocation *> actualSequence, int count) {
+                                            std::vector<Invocation *> &actualSequence, int count) {
             SequenceVerificationEvent evt(VerificationType::AtLeast, _expectedPattern, actualSequence, -_expectedCount,
                                           count);
-            evt.setFileInfo(_file, _line, _testMethod);
+            evt.setFileInfo(_file.str(), _line, _testMethod.str());
             return verificationErrorHandler.handle(evt);
         }
 
@@ -3,8 +3,8 @@
 #include <memory>
 #include "fakeit/FakeitExceptions.hpp"
 #include "fakeit/SequenceVerificationExpectation.hpp"
-#include "fakeit/ThrowFalseEventHandler.hpp"
 #include "mockutils/smart_ptr.hpp"
+#include "mockutils/InternedString.hpp"
 #include "mockutils/to_string.hpp"
 
 
@@ -36,28 +36,42 @@ namespace fakeit {
             _expectationPtr->setExpectedCount(times);
         }
 
+        void verifyExactly(const int times) {
+            if (times < 0) {
+                throw std::invalid_argument(std::string("bad argument times:").append(fakeit::to_string(times)));
+            }
+            verifyInvocations(times);
+        }
+
+        void verifyAtLeast(const int times) {
+            if (times < 0) {
+                throw std::invalid_argument(std::string("bad argument times:").append(fakeit::to_string(times)));
+            }
+            verifyInvocations(-times);
+        }
+
         class Terminator {
             smart_ptr<SequenceVerificationExpectation> _expectationPtr;
 
             bool toBool() {
-                try {
-                    ThrowFalseEventHandler eh;
-                    _expectationPtr->VerifyExpectation(eh);
-                    return true;
-                }
-                catch (bool e) {
-                    return e;
-                }
+                return _expectationPtr->Check();
             }
 
         public:
-            Terminator(smart_ptr<SequenceVerificationExpectation> expectationPtr) : _expectationPtr(expectationPtr) { };
+            Terminator(const smart_ptr<SequenceVerificationExpectation> &expectationPtr) : _expectationPtr(expectationPtr) { };
 
             operator bool() {
                 return toBool();
             }
 
             bool operator!() const { return !const_cast<Terminator *>(this)->toBool(); }
+
+            /**
+             * Tell whether the verification passed. Unlike the destructor, a failure is not reported.
+             */
+            bool Check() {
+                return toBool();
+            }
         };
 
     public:
@@ -65,23 +79,27 @@ namespace fakeit {
         ~SequenceVerificationProgress() THROWS { };
 
         operator bool() {
-            return Terminator(_expectationPtr);
+            return Check();
         }
 
-        bool operator!() const { return !Terminator(_expectationPtr); }
+        bool operator!() const { return !const_cast<SequenceVerificationProgress *>(this)->Check(); }
+
+        bool Check() {
+            return _expectationPtr->Check();
+        }
 
         Terminator Never() {
-            Exactly(0);
+            verifyExactly(0);
             return Terminator(_expectationPtr);
         }
 
         Terminator Once() {
-            Exactly(1);
+            verifyExactly(1);
             return Terminator(_expectationPtr);
         }
 
         Terminator Twice() {
-            Exactly(2);
+            verifyExactly(2);
             return Terminator(_expectationPtr);
         }
 
@@ -91,32 +109,26 @@ namespace fakeit {
         }
 
         Terminator Exactly(const int times) {
-            if (times < 0) {
-                throw std::invalid_argument(std::string("bad argument times:").append(fakeit::to_string(times)));
-            }
-            verifyInvocations(times);
+            verifyExactly(times);
             return Terminator(_expectationPtr);
         }
 
         Terminator Exactly(const Quantity &q) {
-            Exactly(q.quantity);
+            verifyExactly(q.quantity);
             return Terminator(_expectationPtr);
         }
 
         Terminator AtLeast(const int times) {
-            if (times < 0) {
-                throw std::invalid_argument(std::string("bad argument times:").append(fakeit::to_string(times)));
-            }
-            verifyInvocations(-times);
+            verifyAtLeast(times);
             return Terminator(_expectationPtr);
         }
 
         Terminator AtLeast(const Quantity &q) {
-            AtLeast(q.quantity);
+            verifyAtLeast(q.quantity);
             return Terminator(_expectationPtr);
         }
 
-        SequenceVerificationProgress setFileInfo(std::string file, int line, std::string callingMethod) {
+        SequenceVerificationProgress setFileInfo(InternedString file, int line, InternedString callingMethod) {
             _expectationPtr->setFileInfo(file, line, callingMethod);
             return *this;
         }
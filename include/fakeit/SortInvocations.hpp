@@ -7,7 +7,9 @@
  */
 #pragma once
 
-#include <set>
+#include <vector>
+#include <queue>
+#include <algorithm>
 
 #include "fakeit/Invocation.hpp"
 #include "fakeit/ActualInvocation.hpp"
@@ -19,15 +21,52 @@ namespace fakeit {
 
         static void sortByInvocationOrder(std::unordered_set<Invocation *> &ivocations,
                                           std::vector<Invocation *> &result) {
-            auto comparator = [](Invocation *a, Invocation *b) -> bool {
+            size_t first = result.size();
+            result.insert(result.end(), ivocations.begin(), ivocations.end());
+            std::sort(result.begin() + first, result.end(), [](Invocation *a, Invocation *b) -> bool {
                 return a->getOrdinal() < b->getOrdinal();
+            });
+        }
+
+        /**
+         * K-way merge of runs that are each in invocation order, in O(n log k).
+         * An invocation that appears in more than one run is kept once.
+         */
+        static void mergeByInvocationOrder(const InvocationRuns &runs, std::vector<Invocation *> &result) {
+            typedef std::pair<size_t, size_t> Cursor; // run, position in run
+            auto isLater = [&runs](const Cursor &a, const Cursor &b) -> bool {
+                return runs[a.first][a.second]->getOrdinal() > runs[b.first][b.second]->getOrdinal();
             };
-            std::set<Invocation *, bool (*)(Invocation *a, Invocation *b)> sortedIvocations(comparator);
-            for (auto i : ivocations)
-                sortedIvocations.insert(i);
+            std::priority_queue<Cursor, std::vector<Cursor>, decltype(isLater)> heads(isLater);
+            size_t total = 0;
+            for (size_t run = 0; run < runs.size(); run++) {
+                total += runs[run].size();
+                if (!runs[run].empty())
+                    heads.push(Cursor(run, 0));
+            }
+            result.reserve(result.size() + total);
+
+            Invocation *last = nullptr;
+            while (!heads.empty()) {
+                Cursor head = heads.top();
+                heads.pop();
+                Invocation *invocation = runs[head.first][head.second];
+                if (invocation != last) {
+                    result.push_back(invocation);
+                    last = invocation;
+                }
+                if (++head.second < runs[head.first].size())
+                    heads.push(head);
+            }
+        }
 
-            for (auto i : sortedIvocations)
-                result.push_back(i);
+        static void collectActualInvocationsInOrder(std::vector<ActualInvocationsSource *> &invocationSources,
+                                                    std::vector<Invocation *> &result) {
+            InvocationRuns runs;
+            for (auto source : invocationSources) {
+                source->getActualInvocationRuns(runs);
+            }
+            mergeByInvocationOrder(runs, result);
         }
 
         static void collectActualInvocations(std::unordered_set<Invocation *> &actualInvocations,
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "mockutils/type_utils.hpp"
+#include "mockutils/VTUtils.hpp"
+#include "fakeit/DomainObjects.hpp"
+#include "fakeit/FakeitContext.hpp"
+#include "fakeit/MethodMockingContext.hpp"
+#include "fakeit/Prototype.hpp"
+#include "fakeit/RecordedMethodBody.hpp"
+
+namespace fakeit {
+
+    template<typename C>
+    class StaticMock;
+
+    template<typename C, typename Signature>
+    class StaticMethod;
+
+    /**
+     * Holds a part of a static mock that the mock destroys itself, instead of the object that encloses it.
+     * The instance of a static mock may be deleted through its interface, and the method bodies it encloses
+     * must outlive that: the mock still verifies them.
+     */
+    template<typename T>
+    class StaticMockPart {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+
+        StaticMockPart(const StaticMockPart &) = delete;
+
+        StaticMockPart &operator=(const StaticMockPart &) = delete;
+
+    public:
+
+        template<typename ... ctorargs>
+        explicit StaticMockPart(ctorargs &&... args) {
+            new(&_storage) T(std::forward<ctorargs>(args)...);
+        }
+
+        T &operator*() {
+            return *reinterpret_cast<T *>(&_storage);
+        }
+
+        T *operator->() {
+            return reinterpret_cast<T *>(&_storage);
+        }
+
+        void destroy() {
+            (**this).~T();
+        }
+    };
+
+    /**
+     * The body of a method of a static mock. It is a member of the subclass generated by FAKEIT_STATIC_MOCK,
+     * whose override calls it directly: no method proxy, no cookie lookup and, its type being final, no
+     * virtual call.
+     */
+    template<typename C, typename R, typename ... arglist>
+    class StaticMethod<C, R(arglist...)> final : public RecordedMethodBody<R, arglist...> {
+
+        StaticMethod(StaticMock<C> &mock, InternedString methodName, unsigned int offset)
+                : RecordedMethodBody<R, arglist...>(mock.getFakeIt(), methodName, mock.getOptions()) {
+            this->setMethodDetails(mock.getName(), std::move(methodName));
+            mock.addMethod(offset, *this);
+        }
+
+    public:
+
+        typedef R Result;
+
+        template<int N>
+        struct Arg {
+            typedef typename std::tuple_element<N, std::tuple<arglist...>>::type type;
+            typedef typename production_arg<type>::type production;
+        };
+
+        template<typename T>
+        StaticMethod(StaticMock<C> &mock, InternedString methodName, R (T::*vMethod)(arglist...))
+                : StaticMethod(mock, std::move(methodName), VTUtils::getOffset(vMethod)) {
+        }
+
+        template<typename T>
+        StaticMethod(StaticMock<C> &mock, InternedString methodName, R (T::*vMethod)(arglist...) const)
+                : StaticMethod(mock, std::move(methodName), VTUtils::getOffset(reinterpret_cast<R (T::*)(arglist...)>(vMethod))) {
+        }
+    };
+
+    /**
+     * A mock whose type is declared at compile time with FAKEIT_STATIC_MOCK, rather than built at run time
+     * by patching a virtual table. It is stubbed and verified like a Mock: When(Method(mock, foo)), Verify(...),
+     * VerifyNoOtherInvocations(mock). Only the methods declared in the static mock can be stubbed.
+     */
+    template<typename C>
+    class StaticMock : public ActualInvocationsSource, private ListedStatisticsSource {
+
+        // a method of the generated subclass, by its offset in the virtual table of C.
+        struct DeclaredMethod {
+            unsigned int offset;
+            Destructible *body;
+            ActualInvocationsSource *invocations;
+            ReusableMethodBody *reusable;
+            StatisticsSource *statistics;
+        };
+
+        template<typename R, typename ... arglist>
+        class StaticMethodMockingContext : public MethodMockingContext<R, arglist...>::Context {
+            StaticMock<C> &_mock;
+            RecordedMethodBody<R, arglist...> &_body;
+
+        public:
+
+            StaticMethodMockingContext(StaticMock<C> &mock, RecordedMethodBody<R, arglist...> &body)
+                    : _mock(mock), _body(body) {
+            }
+
+            /**
+             * The generated subclass declares every method it mocks: there is no original one to spy.
+             */
+            std::function<R(arglist &...)> getOriginalMethod() override {
+                return [](arglist &...) -> R {
+                    throw std::logic_error("a static mock has no original method to spy");
+                };
+            }
+
+            std::string getMethodName() override {
+                return _body.getMethod().name();
+            }
+
+            void addMethodInvocationHandler(typename ActualInvocation<arglist...>::Matcher *matcher,
+                                            ActualInvocationHandler<R, arglist...> *invocationHandler) override {
+                _body.addMethodInvocationHandler(matcher, invocationHandler);
+            }
+
+            void scanActualInvocations(const std::function<void(ActualInvocation<arglist...> &)> &scanner) override {
+                _body.scanActualInvocations(scanner);
+            }
+
+            unsigned int getInvocationsCount() override {
+                return _body.getInvocationsCount();
+            }
+
+            bool hasDroppedInvocations() override {
+                return _body.hasDroppedInvocations();
+            }
+
+            bool hasDroppedUnverifiedInvocations() override {
+                return _body.hasDroppedUnverifiedInvocations();
+            }
+
+            void markDroppedInvocationsAsVerified() override {
+                _body.markDroppedInvocationsAsVerified();
+            }
+
+            bool mayHaveUnverifiedInvocations() override {
+                return _mock.mayHaveUnverifiedInvocations();
+            }
+
+            void setArgumentsCapture(ArgumentsCapture capture) override {
+                _body.setArgumentsCapture(capture);
+            }
+
+            void setMethodDetails(InternedString mockName, InternedString methodName) override {
+                _body.setMethodDetails(std::move(mockName), std::move(methodName));
+            }
+
+            bool isOfMethod(MethodInfo &method) override {
+                return _body.isOfMethod(method);
+            }
+
+            ActualInvocationsSource &getInvolvedMock() override {
+                return _mock;
+            }
+
+            TraceReplayTarget &getTraceReplayTarget() override {
+                return _body;
+            }
+        };
+
+        FakeitContext &_fakeit;
+        InternedString _name;
+        RecordingOptions _options;
+        unsigned int _unverifiedInvocations; // recorded invocations of all methods that are not verified yet
+        std::vector<DeclaredMethod> _methods;
+        std::shared_ptr<CallStatistics> _statistics;
+        std::shared_ptr<AsyncEventDispatch> _events;
+        StaticMockPart<RecordedMethodBody<void>> _dtor;
+        bool _isInstanceDestroyed;
+
+        // the destructor has no slot of its own among the offsets of the declared methods.
+        static const unsigned int DTOR_OFFSET = std::numeric_limits<unsigned int>::max();
+
+        // a destructor can't throw: deleting the instance does nothing unless Dtor(mock) is stubbed.
+        void fakeDtor() {
+            DtorMockingContext context = dtor();
+            StubbingContext<void> &stubbing = context;
+            stubbing.appendAction(new ReturnDefaultValue<void>());
+            stubbing.commit();
+        }
+
+        template<typename R, typename T, typename ... arglist>
+        MockingContext<R, arglist...> stubMethod(R (T::*vMethod)(arglist...)) {
+            unsigned int offset = VTUtils::getOffset(vMethod);
+            for (DeclaredMethod &method : _methods) {
+                if (method.offset != offset)
+                    continue;
+                auto body = dynamic_cast<RecordedMethodBody<R, arglist...> *>(method.body);
+                if (body)
+                    return MockingContext<R, arglist...>(new StaticMethodMockingContext<R, arglist...>(*this, *body));
+            }
+            throw std::invalid_argument(std::string("can't stub a method that ").append(_name.str())
+                                                .append(" does not declare: add it to its FAKEIT_STATIC_MOCK"));
+        }
+
+        void collectStatistics(std::vector<NamedStatistics> &into) const override {
+            for (const DeclaredMethod &method : _methods) {
+                method.statistics->collectStatistics(into);
+            }
+        }
+
+        void clearStatistics() override {
+            for (DeclaredMethod &method : _methods) {
+                method.statistics->clearStatistics();
+            }
+        }
+
+        StaticMock(const StaticMock &) = delete;
+
+        StaticMock &operator=(const StaticMock &) = delete;
+
+    protected:
+
+        StaticMock(FakeitContext &fakeit, InternedString name, RecordingOptions options)
+                : _fakeit(fakeit), _name(name), _options(options), _unverifiedInvocations(0),
+                  _statistics(fakeit.getCallStatistics()), _events(fakeit.getAsyncEventDispatch()),
+                  _dtor(fakeit, InternedString("dtor"), options), _isInstanceDestroyed(false) {
+            _dtor->setMethodDetails(name, "destructor");
+            addMethod(DTOR_OFFSET, *_dtor);
+            fakeDtor();
+        }
+
+        /**
+         * Called by the generated subclass once its methods are declared.
+         */
+        void attach() {
+            _statistics->add(*this);
+        }
+
+        /**
+         * Called by the generated subclass when it is destroyed. Destroys the instance, unless it was deleted
+         * through its interface, and then the method bodies.
+         */
+        template<typename Instance>
+        void detach(StaticMockPart<Instance> &instance) {
+            _events->wait();
+            _statistics->remove(*this);
+            if (!_isInstanceDestroyed) {
+                _isInstanceDestroyed = true;
+                instance.destroy();
+            }
+            for (DeclaredMethod &method : _methods) {
+                method.body->~Destructible();
+            }
+        }
+
+    public:
+
+        static_assert(std::is_polymorphic<C>::value, "Can only mock a polymorphic type");
+
+        virtual ~StaticMock() = default;
+
+        virtual C &get() = 0;
+
+        C &operator()() {
+            return get();
+        }
+
+        FakeitContext &getFakeIt() {
+            return _fakeit;
+        }
+
+        InternedString getName() const {
+            return _name;
+        }
+
+        RecordingOptions getOptions() const {
+            return _options;
+        }
+
+        template<typename R, typename ... arglist>
+        void addMethod(unsigned int offset, RecordedMethodBody<R, arglist...> &body) {
+            if (!_options.isThreadSafe)
+                body.getMethod().setUnverifiedInvocationsCounter(&_unverifiedInvocations);
+            _methods.push_back(DeclaredMethod{offset, &body, &body, &body, &body});
+        }
+
+        void Reset() {
+            _events->wait();
+            _statistics->retire(*this);
+            for (DeclaredMethod &method : _methods) {
+                method.reusable->clear();
+            }
+            _unverifiedInvocations = 0;
+            fakeDtor();
+        }
+
+        template<int id, typename R, typename T, typename ... arglist, class = typename std::enable_if<
+                std::is_base_of<T, C>::value>::type>
+        MockingContext<R, arglist...> stub(R (T::*vMethod)(arglist...)) {
+            return stubMethod(vMethod);
+        }
+
+        template<int id, typename R, typename T, typename ... arglist, class = typename std::enable_if<
+                std::is_base_of<T, C>::value>::type>
+        MockingContext<R, arglist...> stub(R (T::*vMethod)(arglist...) const) {
+            return stubMethod(reinterpret_cast<R (T::*)(arglist...)>(vMethod));
+        }
+
+        /**
+         * Called by the destructor of the instance. Deleting the instance through its interface is a call of
+         * Dtor(mock): the instance is destroyed, but its memory and the method bodies in it are kept until the
+         * mock is destroyed.
+         */
+        void instanceDestroyed() {
+            if (_isInstanceDestroyed)
+                return;
+            _isInstanceDestroyed = true;
+            _dtor->handleMethodInvocation();
+        }
+
+        DtorMockingContext dtor() {
+            return DtorMockingContext(new StaticMethodMockingContext<void>(*this, *_dtor));
+        }
+
+        void getActualInvocations(std::unordered_set<Invocation *> &into) const override {
+            for (const DeclaredMethod &method : _methods) {
+                method.invocations->getActualInvocations(into);
+            }
+        }
+
+        void getActualInvocationRuns(InvocationRuns &into) const override {
+            for (const DeclaredMethod &method : _methods) {
+                method.invocations->getActualInvocationRuns(into);
+            }
+        }
+
+        bool hasDroppedInvocations() const override {
+            for (const DeclaredMethod &method : _methods) {
+                if (method.invocations->hasDroppedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
+        bool hasDroppedUnverifiedInvocations() const override {
+            for (const DeclaredMethod &method : _methods) {
+                if (method.invocations->hasDroppedUnverifiedInvocations())
+                    return true;
+            }
+            return false;
+        }
+
+        bool mayHaveUnverifiedInvocations() const override {
+            return _unverifiedInvocations > 0 || !_options.isRecording || _options.isThreadSafe;
+        }
+    };
+
+}
+
+/**
+ * Declare a mock type at compile time: a real subclass of the interface whose overrides call the recorded
+ * method bodies directly. Every pure virtual method of the interface must be declared:
+ *
+ *   FAKEIT_STATIC_MOCK(FooMock, IFoo,
+ *       FAKEIT_STATIC_METHOD2(foo, int(int, const std::string &))
+ *       FAKEIT_STATIC_CONST_METHOD0(size, size_t())
+ *   );
+ *
+ *   FooMock mock;
+ *   When(Method(mock, foo)).Return(1);
+ *   IFoo &i = mock.get();
+ *
+ * A method is declared with the number of its arguments and its signature. Overloads are told apart by
+ * the signature.
+ *
+ * Deleting the instance through its interface, or calling its destructor, is recorded as a call of
+ * Dtor(mock) and does nothing unless Dtor(mock) is stubbed. The instance can be deleted once, and its memory
+ * is only freed with the mock. A destructor can't throw, so neither can the action stubbed for it.
+ */
+#define FAKEIT_STATIC_MOCK(name, interface, ...) \
+    class name : public fakeit::StaticMock<interface> { \
+        struct Instance : interface { \
+            typedef interface fakeit_interface; \
+            fakeit::StaticMock<interface> &fakeit_mock; \
+            explicit Instance(fakeit::StaticMock<interface> &mock) : fakeit_mock(mock) { } \
+            ~Instance() { \
+                fakeit_mock.instanceDestroyed(); \
+            } \
+            static void operator delete(void *) { } \
+            __VA_ARGS__ \
+        }; \
+        fakeit::StaticMockPart<Instance> fakeit_instance; \
+    public: \
+        explicit name(fakeit::RecordingOptions options = fakeit::RecordingOptions()) : \
+                fakeit::StaticMock<interface>(Fakeit, #name, options), fakeit_instance(*this) { \
+            attach(); \
+        } \
+        ~name() { \
+            detach(fakeit_instance); \
+        } \
+        interface &get() override { \
+            return *fakeit_instance; \
+        } \
+    }
+
+#define FAKEIT_STATIC_METHOD_(qualifier, getter, arity, method, ...) \
+    FAKEIT_STATIC_METHOD_WITH_ID_(__COUNTER__, qualifier, getter, arity, method, __VA_ARGS__)
+
+// the id tells the declarations of overloads apart.
+#define FAKEIT_STATIC_METHOD_WITH_ID_(id, qualifier, getter, arity, method, ...) \
+    FAKEIT_STATIC_METHOD_DECLARATION_(id, qualifier, getter, arity, method, __VA_ARGS__)
+
+#define FAKEIT_STATIC_METHOD_DECLARATION_(id, qualifier, getter, arity, method, ...) \
+    using fakeit_signature_##id = __VA_ARGS__; \
+    mutable fakeit::StaticMockPart<fakeit::StaticMethod<fakeit_interface, fakeit_signature_##id>> fakeit_body_##id{ \
+        fakeit_mock, #method, \
+        fakeit::Prototype<fakeit_signature_##id>::MemberType<fakeit_interface>::getter(&fakeit_interface::method)}; \
+    fakeit::StaticMethod<fakeit_interface, fakeit_signature_##id>::Result method( \
+            FAKEIT_STATIC_PARAMS_##arity(fakeit_signature_##id)) qualifier override { \
+        return fakeit_body_##id->handleMethodInvocation(FAKEIT_STATIC_ARGS_##arity(fakeit_signature_##id)); \
+    }
+
+#define FAKEIT_STATIC_PARAM_(signature, n) \
+    fakeit::StaticMethod<fakeit_interface, signature>::Arg<n>::type p##n
+
+#define FAKEIT_STATIC_ARG_(signature, n) \
+    static_cast<fakeit::StaticMethod<fakeit_interface, signature>::Arg<n>::production>(p##n)
+
+#define FAKEIT_STATIC_PARAMS_0(s)
+#define FAKEIT_STATIC_PARAMS_1(s) FAKEIT_STATIC_PARAM_(s, 0)
+#define FAKEIT_STATIC_PARAMS_2(s) FAKEIT_STATIC_PARAMS_1(s), FAKEIT_STATIC_PARAM_(s, 1)
+#define FAKEIT_STATIC_PARAMS_3(s) FAKEIT_STATIC_PARAMS_2(s), FAKEIT_STATIC_PARAM_(s, 2)
+#define FAKEIT_STATIC_PARAMS_4(s) FAKEIT_STATIC_PARAMS_3(s), FAKEIT_STATIC_PARAM_(s, 3)
+#define FAKEIT_STATIC_PARAMS_5(s) FAKEIT_STATIC_PARAMS_4(s), FAKEIT_STATIC_PARAM_(s, 4)
+#define FAKEIT_STATIC_PARAMS_6(s) FAKEIT_STATIC_PARAMS_5(s), FAKEIT_STATIC_PARAM_(s, 5)
+#define FAKEIT_STATIC_PARAMS_7(s) FAKEIT_STATIC_PARAMS_6(s), FAKEIT_STATIC_PARAM_(s, 6)
+#define FAKEIT_STATIC_PARAMS_8(s) FAKEIT_STATIC_PARAMS_7(s), FAKEIT_STATIC_PARAM_(s, 7)
+
+#define FAKEIT_STATIC_ARGS_0(s)
+#define FAKEIT_STATIC_ARGS_1(s) FAKEIT_STATIC_ARG_(s, 0)
+#define FAKEIT_STATIC_ARGS_2(s) FAKEIT_STATIC_ARGS_1(s), FAKEIT_STATIC_ARG_(s, 1)
+#define FAKEIT_STATIC_ARGS_3(s) FAKEIT_STATIC_ARGS_2(s), FAKEIT_STATIC_ARG_(s, 2)
+#define FAKEIT_STATIC_ARGS_4(s) FAKEIT_STATIC_ARGS_3(s), FAKEIT_STATIC_ARG_(s, 3)
+#define FAKEIT_STATIC_ARGS_5(s) FAKEIT_STATIC_ARGS_4(s), FAKEIT_STATIC_ARG_(s, 4)
+#define FAKEIT_STATIC_ARGS_6(s) FAKEIT_STATIC_ARGS_5(s), FAKEIT_STATIC_ARG_(s, 5)
+#define FAKEIT_STATIC_ARGS_7(s) FAKEIT_STATIC_ARGS_6(s), FAKEIT_STATIC_ARG_(s, 6)
+#define FAKEIT_STATIC_ARGS_8(s) FAKEIT_STATIC_ARGS_7(s), FAKEIT_STATIC_ARG_(s, 7)
+
+#define FAKEIT_STATIC_METHOD0(method, ...) FAKEIT_STATIC_METHOD_(, get, 0, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD1(method, ...) FAKEIT_STATIC_METHOD_(, get, 1, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD2(method, ...) FAKEIT_STATIC_METHOD_(, get, 2, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD3(method, ...) FAKEIT_STATIC_METHOD_(, get, 3, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD4(method, ...) FAKEIT_STATIC_METHOD_(, get, 4, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD5(method, ...) FAKEIT_STATIC_METHOD_(, get, 5, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD6(method, ...) FAKEIT_STATIC_METHOD_(, get, 6, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD7(method, ...) FAKEIT_STATIC_METHOD_(, get, 7, method, __VA_ARGS__)
+#define FAKEIT_STATIC_METHOD8(method, ...) FAKEIT_STATIC_METHOD_(, get, 8, method, __VA_ARGS__)
+
+#define FAKEIT_STATIC_CONST_METHOD0(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 0, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD1(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 1, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD2(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 2, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD3(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 3, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD4(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 4, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD5(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 5, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD6(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 6, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD7(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 7, method, __VA_ARGS__)
+#define FAKEIT_STATIC_CONST_METHOD8(method, ...) FAKEIT_STATIC_METHOD_(const, getconst, 8, method, __VA_ARGS__)
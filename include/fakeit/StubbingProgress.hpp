@@ -30,22 +30,14 @@ namespace fakeit {
         }
 
         template<typename U = R>
-        typename std::enable_if<!std::is_reference<U>::value, MethodStubbingProgress<R, arglist...> &>::type
-        Return(const R &r) {
-            return Do([r](const typename fakeit::test_arg<arglist>::type...) -> R { return r; });
-        }
-
-        template<typename U = R>
-        typename std::enable_if<std::is_reference<U>::value, MethodStubbingProgress<R, arglist...> &>::type
+        MethodStubbingProgress<R, arglist...> &
         Return(const R &r) {
-            return Do([&r](const typename fakeit::test_arg<arglist>::type...) -> R { return r; });
+            return DoImpl(new ReturnValue<R, arglist...>(r));
         }
 
         MethodStubbingProgress<R, arglist...> &
         Return(const Quantifier<R> &q) {
-            const R &value = q.value;
-            auto method = [value](const arglist &...) -> R { return value; };
-            return DoImpl(new Repeat<R, arglist...>(method, q.quantity));
+            return DoImpl(new ReturnValue<R, arglist...>(q.value, q.quantity));
         }
 
         template<typename first, typename second, typename ... tail>
@@ -57,15 +49,8 @@ namespace fakeit {
 
 
         template<typename U = R>
-        typename std::enable_if<!std::is_reference<U>::value, void>::type
-        AlwaysReturn(const R &r) {
-            return AlwaysDo([r](const typename fakeit::test_arg<arglist>::type...) -> R { return r; });
-        }
-
-        template<typename U = R>
-        typename std::enable_if<std::is_reference<U>::value, void>::type
-        AlwaysReturn(const R &r) {
-            return AlwaysDo([&r](const typename fakeit::test_arg<arglist>::type...) -> R { return r; });
+        void AlwaysReturn(const R &r) {
+            DoImpl(new ReturnValueForever<R, arglist...>(r));
         }
 
         MethodStubbingProgress<R, arglist...> &
@@ -74,7 +59,7 @@ namespace fakeit {
         }
 
         void AlwaysReturn() {
-            return AlwaysDo([](const typename fakeit::test_arg<arglist>::type...) -> R { return DefaultValue<R>::value(); });
+            DoImpl(new ReturnDefaultValue<R, arglist...>());
         }
 
         template<typename E>
@@ -153,7 +138,7 @@ namespace fakeit {
 
 
         void AlwaysReturn() {
-            return AlwaysDo([](const typename fakeit::test_arg<arglist>::type...) -> void { return DefaultValue<void>::value(); });
+            DoImpl(new ReturnDefaultValue<void, arglist...>());
         }
 
         MethodStubbingProgress<void, arglist...> &
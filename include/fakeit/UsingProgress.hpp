@@ -31,6 +31,7 @@ namespace fakeit {
 
         template<typename ... list>
         SequenceVerificationProgress Verify(const fakeit::Sequence &sequence, const list &... tail) {
+            _fakeit.flushEvents(); // the listeners see the events raised before the verification
             std::vector<fakeit::Sequence *> allSequences;
             collectSequences(allSequences, sequence, tail...);
             SequenceVerificationProgress progress(_fakeit, _sources, allSequences);
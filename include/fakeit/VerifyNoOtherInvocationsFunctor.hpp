@@ -32,11 +32,13 @@ namespace fakeit {
         }
 
         void operator()() {
+            _fakeit.flushEvents();
         }
 
         template<typename ... list>
         VerifyNoOtherInvocationsVerificationProgress operator()(const ActualInvocationsSource &head,
                                                                 const list &... tail) {
+            _fakeit.flushEvents(); // the listeners see the events raised before the verification
             std::vector<ActualInvocationsSource *> invocationSources{&InvocationUtils::remove_const(head),
                                                                      &InvocationUtils::remove_const(tail)...};
             VerifyNoOtherInvocationsVerificationProgress progress{_fakeit, invocationSources};
@@ -8,8 +8,10 @@
  */
 #pragma once
 
+#include <stdexcept>
+
 #include "fakeit/FakeitContext.hpp"
-#include "fakeit/ThrowFalseEventHandler.hpp"
+#include "mockutils/InternedString.hpp"
 
 namespace fakeit {
 
@@ -29,7 +31,7 @@ namespace fakeit {
                 VerifyExpectation(_fakeit);
             }
 
-            void setFileInfo(std::string file, int line, std::string callingMethod) {
+            void setFileInfo(InternedString file, int line, InternedString callingMethod) {
                 _file = file;
                 _line = line;
                 _callingMethod = callingMethod;
@@ -40,10 +42,13 @@ namespace fakeit {
             VerificationEventHandler &_fakeit;
             std::vector<ActualInvocationsSource *> _mocks;
 
-            std::string _file;
+            InternedString _file;
             int _line;
-            std::string _callingMethod;
+            InternedString _callingMethod;
             bool _isVerified;
+            std::string _usageError; // why the expectation can't be verified, if it can't
+            std::vector<Invocation *> _actualInvocations;
+            std::vector<Invocation *> _unverifiedInvocations;
 
             VerifyNoOtherInvocationsExpectation(VerificationEventHandler &fakeit,
                                                 std::vector<ActualInvocationsSource *> mocks) :
@@ -55,28 +60,61 @@ namespace fakeit {
 
             VerifyNoOtherInvocationsExpectation(VerifyNoOtherInvocationsExpectation &other) = default;
 
+            /**
+             * Mocks keep a count of their unverified invocations, so the common case where everything was
+             * verified is decided without collecting any invocation.
+             */
+            bool mayHaveUnverifiedInvocations() const {
+                for (ActualInvocationsSource *mock : _mocks) {
+                    if (mock->mayHaveUnverifiedInvocations())
+                        return true;
+                }
+                return false;
+            }
+
             void VerifyExpectation(VerificationEventHandler &verificationErrorHandler) {
                 if (_isVerified)
                     return;
-                _isVerified = true;
-
-                std::unordered_set<Invocation *> actualInvocations;
-                InvocationUtils::collectActualInvocations(actualInvocations, _mocks);
+                if (!Check())
+                    reportFailure(verificationErrorHandler);
+            }
 
-                std::unordered_set<Invocation *> nonVerifiedInvocations;
-                InvocationUtils::selectNonVerifiedInvocations(actualInvocations, nonVerifiedInvocations);
+            /**
+             * Verify once and tell whether no other invocations were made, without reporting a failure.
+             */
+            bool Check() {
+                if (_isVerified) {
+                    if (!_usageError.empty())
+                        throw std::invalid_argument(_usageError);
+                    return _unverifiedInvocations.empty();
+                }
+                _isVerified = true;
 
-                if (nonVerifiedInvocations.size() > 0) {
-                    std::vector<Invocation *> sortedNonVerifiedInvocations;
-                    InvocationUtils::sortByInvocationOrder(nonVerifiedInvocations, sortedNonVerifiedInvocations);
+                if (mayHaveUnverifiedInvocations()) {
+                    InvocationUtils::collectActualInvocationsInOrder(_mocks, _actualInvocations);
+                    for (Invocation *invocation : _actualInvocations) {
+                        if (!invocation->isVerified())
+                            _unverifiedInvocations.push_back(invocation);
+                    }
 
-                    std::vector<Invocation *> sortedActualInvocations;
-                    InvocationUtils::sortByInvocationOrder(actualInvocations, sortedActualInvocations);
+                    if (_unverifiedInvocations.size() > 0)
+                        return false;
+                }
 
-                    NoMoreInvocationsVerificationEvent evt(sortedActualInvocations, sortedNonVerifiedInvocations);
-                    evt.setFileInfo(_file, _line, _callingMethod);
-                    return verificationErrorHandler.handle(evt);
+                for (ActualInvocationsSource *mock : _mocks) {
+                    if (mock->hasDroppedUnverifiedInvocations()) {
+                        _usageError = "can't verify no other invocations: invocations were dropped from a KeepLast "
+                                "invocation history";
+                        throw std::invalid_argument(_usageError);
+                    }
                 }
+                return true;
+            }
+
+            void reportFailure(VerificationEventHandler &verificationErrorHandler) {
+                NoMoreInvocationsVerificationEvent evt(_actualInvocations, _unverifiedInvocations);
+                evt.setFileInfo(_file.str(), _line, _callingMethod.str());
+                return verificationErrorHandler.handle(evt);
             }
 
         };
@@ -95,14 +133,7 @@ namespace fakeit {
         }
 
         bool toBool() {
-            try {
-                ThrowFalseEventHandler ev;
-                _ptr->VerifyExpectation(ev);
-                return true;
-            }
-            catch (bool e) {
-                return e;
-            }
+            return _ptr->Check();
         }
 
     public:
@@ -111,8 +142,8 @@ namespace fakeit {
         ~VerifyNoOtherInvocationsVerificationProgress() THROWS {
         };
 
-        VerifyNoOtherInvocationsVerificationProgress setFileInfo(std::string file, int line,
-                                                                 std::string callingMethod) {
+        VerifyNoOtherInvocationsVerificationProgress setFileInfo(InternedString file, int line,
+                                                                 InternedString callingMethod) {
             _ptr->setFileInfo(file, line, callingMethod);
             return *this;
         }
@@ -123,6 +154,13 @@ namespace fakeit {
 
         bool operator!() const { return !const_cast<VerifyNoOtherInvocationsVerificationProgress *>(this)->toBool(); }
 
+        /**
+         * Tell whether no other invocations were made. Unlike the destructor, a failure is not reported.
+         */
+        bool Check() {
+            return toBool();
+        }
+
     };
 
 }
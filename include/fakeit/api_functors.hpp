@@ -7,6 +7,7 @@
 #include "fakeit/FakeFunctor.hpp"
 #include "fakeit/WhenFunctor.hpp"
 #include "fakeit/UnverifiedFunctor.hpp"
+#include "fakeit/ReplayTraceFunctor.hpp"
 
 namespace fakeit {
 
@@ -17,6 +18,7 @@ namespace fakeit {
     static SpyFunctor Spy;
     static FakeFunctor Fake;
     static WhenFunctor When;
+    static ReplayTraceFunctor ReplayTrace;
 
     template<class T>
     class SilenceUnusedVariableWarnings {
@@ -31,6 +33,9 @@ namespace fakeit {
             use(&Using);
             use(&Verify);
             use(&VerifyNoOtherInvocations);
+            use(&ReplayTrace);
+            use(&NoRecording);
+            use(&ThreadSafe);
             use(&_);
         }
     };
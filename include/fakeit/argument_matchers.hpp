@@ -20,6 +20,12 @@ namespace fakeit {
         virtual bool matches(const T &actual) const = 0;
     };
 
+    /**
+     * Creates the matcher of one argument in Using(...).
+     * A creator may also provide a non virtual "createMatcherByValue() const" that returns its concrete
+     * matcher type. When every argument of Using(...) has one, the matchers are kept by value and called
+     * without virtual dispatch.
+     */
     template<typename T>
     struct TypedMatcherCreator {
 
@@ -71,6 +77,10 @@ namespace fakeit {
                 return new Matcher();
             }
 
+            Matcher createMatcherByValue() const {
+                return Matcher();
+            }
+
         };
 
         template<typename T>
@@ -100,6 +110,10 @@ namespace fakeit {
                 return new Matcher(this->_expected);
             }
 
+            Matcher createMatcherByValue() const {
+                return Matcher(this->_expected);
+            }
+
         };
 
         template<typename T>
@@ -128,6 +142,10 @@ namespace fakeit {
             virtual TypedMatcher<T> *createMatcher() const override {
                 return new Matcher(this->_expected);
             }
+
+            Matcher createMatcherByValue() const {
+                return Matcher(this->_expected);
+            }
         };
 
         template<typename T>
@@ -156,6 +174,10 @@ namespace fakeit {
             virtual TypedMatcher<T> *createMatcher() const override {
                 return new Matcher(this->_expected);
             }
+
+            Matcher createMatcherByValue() const {
+                return Matcher(this->_expected);
+            }
         };
 
         template<typename T>
@@ -185,6 +207,10 @@ namespace fakeit {
                 return new Matcher(this->_expected);
             }
 
+            Matcher createMatcherByValue() const {
+                return Matcher(this->_expected);
+            }
+
         };
 
         template<typename T>
@@ -214,6 +240,10 @@ namespace fakeit {
                 return new Matcher(this->_expected);
             }
 
+            Matcher createMatcherByValue() const {
+                return Matcher(this->_expected);
+            }
+
         };
 
         template<typename T>
@@ -244,6 +274,10 @@ namespace fakeit {
                 return new Matcher(this->_expected);
             }
 
+            Matcher createMatcherByValue() const {
+                return Matcher(this->_expected);
+            }
+
         };
     }
 
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "fakeit/Mock.hpp"
+#include "fakeit/StaticMock.hpp"
 #include "fakeit/WhenFunctor.hpp"
 #include "fakeit/FakeFunctor.hpp"
 #include "fakeit/UsingFunctor.hpp"
 #include "fakeit/VerifyFunctor.hpp"
 #include "fakeit/VerifyNoOtherInvocationsFunctor.hpp"
 #include "fakeit/SpyFunctor.hpp"
+#include "fakeit/ReplayTraceFunctor.hpp"
 #include "fakeit/api_functors.hpp"
 #include "fakeit/api_macros.hpp"
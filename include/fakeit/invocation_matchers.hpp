@@ -12,9 +12,13 @@
 #include <tuple>
 #include <string>
 #include <iosfwd>
+#include <sstream>
+#include <type_traits>
+#include <utility>
 
 #include "mockutils/TupleDispatcher.hpp"
 #include "mockutils/TuplePrinter.hpp"
+#include "mockutils/TupleHash.hpp"
 #include "mockutils/DefaultValue.hpp"
 #include "mockutils/type_utils.hpp"
 #include "fakeit/ActualInvocation.hpp"
@@ -61,10 +65,12 @@ namespace fakeit {
 
             template<typename A>
             void operator()(int index, A &actualArg) {
+                if (!_matching)
+                    return;
+                // the collector created a TypedMatcher of this argument type at this index.
                 TypedMatcher<typename naked_type<A>::type> *matcher =
-                        dynamic_cast<TypedMatcher<typename naked_type<A>::type> *>(_matchers[index]);
-                if (_matching)
-                    _matching = matcher->matches(actualArg);
+                        static_cast<TypedMatcher<typename naked_type<A>::type> *>(_matchers[index]);
+                _matching = matcher->matches(actualArg);
             }
 
             bool isMatching() {
@@ -85,6 +91,109 @@ namespace fakeit {
         const std::vector<Destructible *> _matchers;
     };
 
+    /**
+     * Matches the arguments with matchers that are kept by value in a tuple, so their types are known at
+     * compile time. Each comparison is a direct call that can be inlined, and matching stops at the first
+     * argument that doesn't match.
+     */
+    template<typename Matchers, typename ... arglist>
+    struct TypedArgumentsMatcherInvocationMatcher : public ActualInvocation<arglist...>::Matcher {
+
+        virtual ~TypedArgumentsMatcherInvocationMatcher() = default;
+
+        TypedArgumentsMatcherInvocationMatcher(Matchers &&matchers)
+                : _matchers(std::move(matchers)) {
+        }
+
+        virtual bool matches(ActualInvocation<arglist...> &invocation) override {
+            if (invocation.getActualMatcher() == this)
+                return true;
+            return matchesFrom<0>(invocation.getActualArguments());
+        }
+
+        virtual std::string format() const override {
+            std::ostringstream out;
+            out << "(";
+            formatFrom<0>(out);
+            out << ")";
+            return out.str();
+        }
+
+        virtual bool getExpectedArgumentsHash(size_t &hash) const override {
+            return getExpectedArgumentsHash(
+                    std::integral_constant<bool, isEqualityOnly<sizeof...(arglist)>()>(), hash);
+        }
+
+    private:
+
+        template<size_t N>
+        using NakedArgType = typename naked_type<typename std::tuple_element<N, std::tuple<arglist...>>::type>::type;
+
+        // are the first N matchers Eq matchers of hashable types?
+        template<size_t N>
+        static constexpr typename std::enable_if<N == 0, bool>::type isEqualityOnly() {
+            return true;
+        }
+
+        template<size_t N>
+        static constexpr typename std::enable_if<(N > 0), bool>::type isEqualityOnly() {
+            return isEqualityOnly<N - 1>() && is_hashable<NakedArgType<N - 1>>::value &&
+                   std::is_same<typename std::tuple_element<N - 1, Matchers>::type,
+                           typename internal::EqMatcherCreator<NakedArgType<N - 1>>::Matcher>::value;
+        }
+
+        bool getExpectedArgumentsHash(std::true_type, size_t &hash) const {
+            hash = expectedArgumentsHash<sizeof...(arglist)>();
+            return true;
+        }
+
+        bool getExpectedArgumentsHash(std::false_type, size_t &) const {
+            return false;
+        }
+
+        // the same as TupleHash of the expected values.
+        template<size_t N>
+        typename std::enable_if<N == 0, size_t>::type expectedArgumentsHash() const {
+            return 0;
+        }
+
+        template<size_t N>
+        typename std::enable_if<(N > 0), size_t>::type expectedArgumentsHash() const {
+            return combineHash(expectedArgumentsHash<N - 1>(),
+                               std::hash<NakedArgType<N - 1>>()(std::get<N - 1>(_matchers)._expected));
+        }
+
+        template<size_t N>
+        typename std::enable_if<N == sizeof...(arglist), bool>::type
+        matchesFrom(ArgumentsTuple<arglist...> &) const {
+            return true;
+        }
+
+        template<size_t N>
+        typename std::enable_if<(N < sizeof...(arglist)), bool>::type
+        matchesFrom(ArgumentsTuple<arglist...> &actualArguments) const {
+            typedef typename std::tuple_element<N, Matchers>::type Matcher;
+            // a qualified call, so it is not dispatched through the vtable.
+            return std::get<N>(_matchers).Matcher::matches(std::get<N>(actualArguments)) &&
+                   matchesFrom<N + 1>(actualArguments);
+        }
+
+        template<size_t N>
+        typename std::enable_if<N == sizeof...(arglist), void>::type
+        formatFrom(std::ostream &) const {
+        }
+
+        template<size_t N>
+        typename std::enable_if<(N < sizeof...(arglist)), void>::type
+        formatFrom(std::ostream &out) const {
+            if (N > 0) out << ", ";
+            out << std::get<N>(_matchers).format();
+            formatFrom<N + 1>(out);
+        }
+
+        const Matchers _matchers;
+    };
+
 //template<typename ... arglist>
 //struct ExpectedArgumentsInvocationMatcher: public ActualInvocation<arglist...>::Matcher {
 //
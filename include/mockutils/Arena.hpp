@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <type_traits>
+
+namespace fakeit {
+
+    /**
+     * Storage for objects of a single type that are appended at the back.
+     * Objects are constructed in place inside large chunks, so appending costs no allocation in the common
+     * case and neighbouring records are contiguous in memory. Chunks never move, so pointers to stored
+     * objects stay valid until the objects are removed, the arena is cleared or it is destroyed.
+     * Objects can also be removed from the front, which lets the arena hold a sliding window of the most
+     * recent objects. A drained chunk is kept as a spare for the next append.
+     * An object erased from the middle leaves a hole that iteration skips, so the objects after it keep
+     * their place.
+     */
+    template<typename T>
+    class Arena {
+
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+        static const size_t FIRST_CHUNK_CAPACITY = 8;
+        static const size_t MAX_CHUNK_CAPACITY = 1024;
+
+        struct Chunk {
+            std::unique_ptr<Slot[]> slots;
+            size_t capacity;
+            size_t begin;
+            size_t end;
+
+            T &at(size_t i) const {
+                return *reinterpret_cast<T *>(&slots[i]);
+            }
+        };
+
+        std::deque<Chunk> _chunks;
+        std::unique_ptr<Chunk> _spare;
+        size_t _size;
+        std::unordered_set<const T *> _holes; // erased objects still taking a slot, never the first or last one
+
+        Chunk &chunkWithFreeSlot() {
+            if (_chunks.empty() || _chunks.back().end == _chunks.back().capacity) {
+                size_t capacity = _chunks.empty() ? FIRST_CHUNK_CAPACITY : _chunks.back().capacity * 2;
+                if (capacity > MAX_CHUNK_CAPACITY)
+                    capacity = MAX_CHUNK_CAPACITY;
+                if (_spare && _spare->capacity >= capacity) {
+                    _chunks.push_back(std::move(*_spare));
+                    _spare.reset();
+                } else {
+                    _chunks.push_back(Chunk{std::unique_ptr<Slot[]>{new Slot[capacity]}, capacity, 0, 0});
+                }
+            }
+            return _chunks.back();
+        }
+
+        void recycle(Chunk &chunk) {
+            chunk.begin = 0;
+            chunk.end = 0;
+            if (!_spare)
+                _spare.reset(new Chunk(std::move(chunk)));
+            else if (_spare->capacity < chunk.capacity)
+                *_spare = std::move(chunk);
+        }
+
+        bool isHole(const T &object) const {
+            return !_holes.empty() && _holes.count(&object) > 0;
+        }
+
+        void dropLastSlot() {
+            Chunk &chunk = _chunks.back();
+            chunk.end--;
+            if (chunk.begin == chunk.end) {
+                recycle(chunk);
+                _chunks.pop_back();
+            }
+        }
+
+        void dropFirstSlot() {
+            Chunk &chunk = _chunks.front();
+            chunk.begin++;
+            if (chunk.begin == chunk.end) {
+                recycle(chunk);
+                _chunks.pop_front();
+            }
+        }
+
+        Arena(const Arena &) = delete;
+
+        Arena &operator=(const Arena &) = delete;
+
+    public:
+
+        Arena() : _size{0} {
+        }
+
+        ~Arena() {
+            clear();
+        }
+
+        template<typename ... ctorargs>
+        T *emplace_back(ctorargs &&... args) {
+            Chunk &chunk = chunkWithFreeSlot();
+            T *object = new(&chunk.slots[chunk.end]) T(std::forward<ctorargs>(args)...);
+            chunk.end++;
+            _size++;
+            return object;
+        }
+
+        /**
+         * Destroy the most recently appended object.
+         */
+        void pop_back() {
+            back().~T();
+            _size--;
+            dropLastSlot();
+            while (!_holes.empty() && _holes.erase(&back()) > 0) {
+                dropLastSlot();
+            }
+        }
+
+        /**
+         * Destroy the oldest object.
+         */
+        void pop_front() {
+            front().~T();
+            _size--;
+            dropFirstSlot();
+            while (!_holes.empty() && _holes.erase(&front()) > 0) {
+                dropFirstSlot();
+            }
+        }
+
+        /**
+         * Destroy the given object, wherever it is.
+         */
+        void erase(T *object) {
+            if (object == &back()) {
+                pop_back();
+            } else if (object == &front()) {
+                pop_front();
+            } else {
+                object->~T();
+                _size--;
+                _holes.insert(object);
+            }
+        }
+
+        /**
+         * Destroy all objects. The largest chunk is kept as the spare, so an arena that is cleared and
+         * refilled, like the log of a mock reset between test cases, doesn't allocate again.
+         */
+        void clear() {
+            for (Chunk &chunk : _chunks) {
+                for (size_t i = chunk.begin; i < chunk.end; i++) {
+                    if (!isHole(chunk.at(i)))
+                        chunk.at(i).~T();
+                }
+                recycle(chunk);
+            }
+            _chunks.clear();
+            _holes.clear();
+            _size = 0;
+        }
+
+        T &front() const {
+            const Chunk &chunk = _chunks.front();
+            return chunk.at(chunk.begin);
+        }
+
+        T &back() const {
+            const Chunk &chunk = _chunks.back();
+            return chunk.at(chunk.end - 1);
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        template<typename F>
+        void forEach(F f) const {
+            for (const Chunk &chunk : _chunks) {
+                for (size_t i = chunk.begin; i < chunk.end; i++) {
+                    if (!isHole(chunk.at(i)))
+                        f(chunk.at(i));
+                }
+            }
+        }
+    };
+}
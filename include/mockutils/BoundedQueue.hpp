@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+namespace fakeit {
+
+    /**
+     * A fixed size FIFO queue that several threads can push to and pop from without a lock.
+     * Each slot carries a sequence number that tells producers and consumers whose turn it is, so a push or a
+     * pop is one compare and swap on the position plus one store to the slot. A push to a full queue and a
+     * pop from an empty one fail instead of waiting: what to do then is up to the caller.
+     */
+    template<typename T>
+    class BoundedQueue {
+
+        struct Slot {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        // keeps the positions, written by different threads, on different cache lines
+        struct Position {
+            std::atomic<size_t> value;
+            char padding[64 - sizeof(std::atomic<size_t>)];
+        };
+
+        std::unique_ptr<Slot[]> _slots;
+        const size_t _mask;
+        Position _pushPosition;
+        Position _popPosition;
+
+        static size_t roundUpToPowerOfTwo(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity)
+                size *= 2;
+            return size;
+        }
+
+        BoundedQueue(const BoundedQueue &) = delete;
+
+        BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    public:
+
+        /**
+         * The capacity is rounded up to a power of two.
+         */
+        explicit BoundedQueue(size_t capacity) :
+                _slots{new Slot[roundUpToPowerOfTwo(capacity)]}, _mask{roundUpToPowerOfTwo(capacity) - 1} {
+            for (size_t i = 0; i <= _mask; i++) {
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            _pushPosition.value.store(0, std::memory_order_relaxed);
+            _popPosition.value.store(0, std::memory_order_relaxed);
+        }
+
+        size_t capacity() const {
+            return _mask + 1;
+        }
+
+        /**
+         * Returns false, leaving the queue as is, if it is full.
+         */
+        bool tryPush(const T &value) {
+            size_t position = _pushPosition.value.load(std::memory_order_relaxed);
+            for (; ;) {
+                Slot &slot = _slots[position & _mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t turn = (intptr_t) sequence - (intptr_t) position;
+                if (turn == 0) {
+                    if (_pushPosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.value = value;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (turn < 0) {
+                    return false;
+                } else {
+                    position = _pushPosition.value.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Returns false, leaving the argument as is, if the queue is empty.
+         */
+        bool tryPop(T &into) {
+            size_t position = _popPosition.value.load(std::memory_order_relaxed);
+            for (; ;) {
+                Slot &slot = _slots[position & _mask];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t turn = (intptr_t) sequence - (intptr_t) (position + 1);
+                if (turn == 0) {
+                    if (_popPosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        into = slot.value;
+                        slot.sequence.store(position + _mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (turn < 0) {
+                    return false;
+                } else {
+                    position = _popPosition.value.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Whether nothing was pushed that was not popped yet. A push in progress counts as pushed.
+         */
+        bool isEmpty() const {
+            return _pushPosition.value.load() == _popPosition.value.load();
+        }
+    };
+
+}
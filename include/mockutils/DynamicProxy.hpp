@@ -17,37 +17,85 @@
 #include "mockutils/union_cast.hpp"
 #include "mockutils/MethodInvocationHandler.hpp"
 #include "mockutils/VTUtils.hpp"
+#include "mockutils/Pool.hpp"
 #include "mockutils/FakeObject.hpp"
 #include "mockutils/MethodProxy.hpp"
 #include "mockutils/MethodProxyCreator.hpp"
 
 namespace fakeit {
 
+    /**
+     * Maps the id of a method proxy to the handler bound to it.
+     * This lookup runs on every mocked call, so it is an open addressing table sized once (from the
+     * vtable size) to a load factor below 1/2. Ids are sequential (__COUNTER__ based), so probing
+     * almost always stops at the first slot.
+     */
     class InvocationHandlers : public InvocationHandlerCollection {
-        std::vector<std::shared_ptr<Destructible>> &_methodMocks;
-        std::vector<unsigned int> &_offsets;
-
-        unsigned int getOffset(unsigned int id) {
-            unsigned int offset = 0;
-            for (; offset < _offsets.size(); offset++) {
-                if (_offsets[offset] == id) {
-                    break;
-                }
+    public:
+
+        struct Entry {
+            unsigned int id;
+            Destructible *handler;
+        };
+
+        typedef std::vector<Entry> Table;
+
+    private:
+
+        Table _entries;
+        std::vector<unsigned int> _used; // indexes of the bound entries, so clearing doesn't scan the table
+        unsigned int _mask;
+        Pool<Table> &_pool;
+
+        static unsigned int tableSize(unsigned int vtSize) {
+            unsigned int size = 1;
+            while (size < 2 * vtSize + 1) {
+                size <<= 1;
             }
-            return offset;
+            return size;
         }
 
     public:
-        InvocationHandlers(
-                std::vector<std::shared_ptr<Destructible>> &methodMocks,
-                std::vector<unsigned int> &offsets) :
-                _methodMocks(methodMocks), _offsets(offsets) {
+        /**
+         * Tables are taken from, and given back to, a pool of tables of the same size.
+         */
+        InvocationHandlers(unsigned int vtSize, Pool<Table> &pool) :
+                _mask(tableSize(vtSize) - 1), _pool(pool) {
+            if (!_pool.acquire(_entries))
+                _entries.assign(tableSize(vtSize), Entry{0, nullptr});
+        }
+
+        ~InvocationHandlers() {
+            clear();
+            _pool.release(_entries);
+        }
+
+        void bind(unsigned int id, Destructible *handler) {
+            unsigned int index = id & _mask;
+            while (_entries[index].handler != nullptr && _entries[index].id != id) {
+                index = (index + 1) & _mask;
+            }
+            if (_entries[index].handler == nullptr)
+                _used.push_back(index);
+            _entries[index] = Entry{id, handler};
+        }
+
+        void clear() {
+            for (unsigned int index : _used) {
+                _entries[index] = Entry{0, nullptr};
+            }
+            _used.clear();
         }
 
         Destructible *getInvocatoinHandlerPtrById(unsigned int id) override {
-            unsigned int offset = getOffset(id);
-            std::shared_ptr<Destructible> ptr = _methodMocks[offset];
-            return ptr.get();
+            unsigned int index = id & _mask;
+            while (_entries[index].handler != nullptr) {
+                if (_entries[index].id == id) {
+                    return _entries[index].handler;
+                }
+                index = (index + 1) & _mask;
+            }
+            return nullptr;
         }
 
     };
@@ -60,9 +108,8 @@ namespace fakeit {
         DynamicProxy(C &inst) :
                 instance(inst),
                 originalVtHandle(VirtualTable<C, baseclasses...>::getVTable(instance).createHandle()),
-                _methodMocks(VTUtils::getVTSize<C>()),
-                _offsets(VTUtils::getVTSize<C>()),
-                _invocationHandlers(_methodMocks, _offsets) {
+                _methodMocks(acquireMethodMocks()),
+                _invocationHandlers(VTUtils::getVTSize<C>(), invocationHandlersPool()) {
             _cloneVt.copyFrom(originalVtHandle.restore());
             _cloneVt.setCookie(InvocationHandlerCollection::VT_COOKIE_INDEX, &_invocationHandlers);
             getFake().setVirtualTable(_cloneVt);
@@ -74,19 +121,52 @@ namespace fakeit {
 
         ~DynamicProxy() {
             _cloneVt.dispose();
+            for (std::shared_ptr<Destructible> &methodMock : _methodMocks) {
+                methodMock.reset();
+            }
+            methodMocksPool().release(_methodMocks);
         }
 
         C &get() {
             return instance;
         }
 
+        /**
+         * Unbind all methods and drop the data members, keeping the storage: only the slots of bound methods
+         * are restored, and their handlers stay in place, unbound. Stubbing such a method again binds the same
+         * handler, so the owner is expected to clear the handlers.
+         */
         void Reset() {
-            _methodMocks = {{}};
-            _methodMocks.resize(VTUtils::getVTSize<C>());
-            _members = {};
-            _offsets = {};
-            _offsets.resize(VTUtils::getVTSize<C>());
-            _cloneVt.copyFrom(originalVtHandle.restore());
+            VirtualTable<C, baseclasses...> &original = originalVtHandle.restore();
+            const VTUtils::Metadata<C> &metadata = VTUtils::getMetadata<C>();
+            for (const MethodProxy &methodProxy : _boundMethods) {
+                unsigned int offset = methodProxy.getOffset();
+                if (metadata.hasVirtualDtor && offset == metadata.dtorOffset) {
+                    _cloneVt.copyDtorFrom(original);
+                } else {
+                    _cloneVt.setMethod(offset, original.getMethod(offset));
+                }
+            }
+            _boundMethods.clear();
+            _members.clear();
+            _invocationHandlers.clear();
+        }
+
+        /**
+         * Bind the methods that are bound in another proxy to the same method proxies. Each one gets the handler
+         * that createHandler makes of the handler it has in the other proxy.
+         */
+        template<typename F>
+        void bindLike(const DynamicProxy &other, F createHandler) {
+            const VTUtils::Metadata<C> &metadata = VTUtils::getMetadata<C>();
+            for (const MethodProxy &methodProxy : other._boundMethods) {
+                Destructible *handler = other._methodMocks[methodProxy.getOffset()].get();
+                if (metadata.hasVirtualDtor && methodProxy.getOffset() == metadata.dtorOffset) {
+                    bindDtor(methodProxy, createHandler(handler));
+                } else {
+                    bind(methodProxy, createHandler(handler));
+                }
+            }
         }
 
         template<int id, typename R, typename ... arglist>
@@ -116,14 +196,12 @@ namespace fakeit {
         template<typename R, typename ... arglist>
         Destructible *getMethodMock(R(C::*vMethod)(arglist...)) {
             auto offset = VTUtils::getOffset(vMethod);
-            std::shared_ptr<Destructible> ptr = _methodMocks[offset];
-            return ptr.get();
+            return _methodMocks[offset].get();
         }
 
         Destructible *getDtorMock() {
             auto offset = VTUtils::getDestructorOffset<C>();
-            std::shared_ptr<Destructible> ptr = _methodMocks[offset];
-            return ptr.get();
+            return _methodMocks[offset].get();
         }
 
         template<typename DATA_TYPE, typename ... arglist>
@@ -137,10 +215,13 @@ namespace fakeit {
                     initargs...)});
         }
 
+        /**
+         * The handlers of the bound methods of the given type. Handlers left unbound by Reset are not included.
+         */
         template<typename DATA_TYPE>
         void getMethodMocks(std::vector<DATA_TYPE> &into) const {
-            for (std::shared_ptr<Destructible> ptr : _methodMocks) {
-                DATA_TYPE p = dynamic_cast<DATA_TYPE>(ptr.get());
+            for (const MethodProxy &methodProxy : _boundMethods) {
+                DATA_TYPE p = dynamic_cast<DATA_TYPE>(_methodMocks[methodProxy.getOffset()].get());
                 if (p) {
                     into.push_back(p);
                 }
@@ -172,35 +253,60 @@ namespace fakeit {
 
         static_assert(sizeof(C) == sizeof(FakeObject<C, baseclasses...>), "This is a problem");
 
+        typedef std::vector<std::shared_ptr<Destructible>> MethodMocks;
+
         C &instance;
         typename VirtualTable<C, baseclasses...>::Handle originalVtHandle; // avoid delete!! this is the original!
         VirtualTable<C, baseclasses...> _cloneVt;
         //
-        std::vector<std::shared_ptr<Destructible>> _methodMocks;
+        MethodMocks _methodMocks;
+        std::vector<MethodProxy> _boundMethods; // in binding order, so bindLike doesn't scan the whole vtable
         std::vector<std::shared_ptr<Destructible>> _members;
-        std::vector<unsigned int> _offsets;
         InvocationHandlers _invocationHandlers;
 
+        // the tables of destroyed proxies, all sized for the vtable of C.
+        static Pool<MethodMocks> &methodMocksPool() {
+            static Pool<MethodMocks> *pool = new Pool<MethodMocks>();
+            return *pool;
+        }
+
+        static Pool<InvocationHandlers::Table> &invocationHandlersPool() {
+            static Pool<InvocationHandlers::Table> *pool = new Pool<InvocationHandlers::Table>();
+            return *pool;
+        }
+
+        static MethodMocks acquireMethodMocks() {
+            MethodMocks methodMocks;
+            if (!methodMocksPool().acquire(methodMocks))
+                methodMocks.resize(VTUtils::getVTSize<C>());
+            return methodMocks;
+        }
+
         FakeObject<C, baseclasses...> &getFake() {
             return reinterpret_cast<FakeObject<C, baseclasses...> &>(instance);
         }
 
         void bind(const MethodProxy &methodProxy, Destructible *invocationHandler) {
+            if (!isBinded(methodProxy.getOffset()))
+                _boundMethods.push_back(methodProxy);
             getFake().setMethod(methodProxy.getOffset(), methodProxy.getProxy());
-            _methodMocks[methodProxy.getOffset()].reset(invocationHandler);
-            _offsets[methodProxy.getOffset()] = methodProxy.getId();
+            if (_methodMocks[methodProxy.getOffset()].get() != invocationHandler)
+                _methodMocks[methodProxy.getOffset()].reset(invocationHandler);
+            _invocationHandlers.bind(methodProxy.getId(), invocationHandler);
         }
 
         void bindDtor(const MethodProxy &methodProxy, Destructible *invocationHandler) {
+            if (!isBinded(methodProxy.getOffset()))
+                _boundMethods.push_back(methodProxy);
             getFake().setDtor(methodProxy.getProxy());
-            _methodMocks[methodProxy.getOffset()].reset(invocationHandler);
-            _offsets[methodProxy.getOffset()] = methodProxy.getId();
+            if (_methodMocks[methodProxy.getOffset()].get() != invocationHandler)
+                _methodMocks[methodProxy.getOffset()].reset(invocationHandler);
+            _invocationHandlers.bind(methodProxy.getId(), invocationHandler);
         }
 
         template<typename DATA_TYPE>
         DATA_TYPE getMethodMock(unsigned int offset) {
-            std::shared_ptr<Destructible> ptr = _methodMocks[offset];
-            return dynamic_cast<DATA_TYPE>(ptr.get());
+            return dynamic_cast<DATA_TYPE>(_methodMocks[offset].get());
         }
 
         template<typename BaseClass>
@@ -215,9 +321,9 @@ namespace fakeit {
             }
         }
 
+        // a handler left by Reset is not bound, the slot tells.
         bool isBinded(unsigned int offset) {
-            std::shared_ptr<Destructible> ptr = _methodMocks[offset];
-            return ptr.get() != nullptr;
+            return _cloneVt.getMethod(offset) != originalVtHandle.restore().getMethod(offset);
         }
 
     };
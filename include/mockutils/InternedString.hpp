@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <ostream>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace fakeit {
+
+    /**
+     * A handle to an immutable string. Equal strings share one reference counted copy, so a handle is a single
+     * pointer: comparing handles allocates nothing, and interning a string that is already known doesn't allocate
+     * either. Copies without handles are freed in batches, when the pool has doubled since the last batch, so
+     * a name that is released and interned again, as by a mock created for each test, is not reallocated
+     * each time.
+     * The pool of copies is split into shards, each with its own lock. Only interning takes it: copying and
+     * releasing a handle don't.
+     */
+    class InternedString {
+    public:
+
+        InternedString() : _entry(emptyEntry()) {
+        }
+
+        InternedString(const char *value) : _entry(intern(value, std::strlen(value))) {
+        }
+
+        InternedString(const std::string &value) : _entry(intern(value.data(), value.size())) {
+        }
+
+        InternedString(const InternedString &other) : _entry(other._entry) {
+            retain(_entry);
+        }
+
+        // leaves the empty string behind, which takes no count.
+        InternedString(InternedString &&other) : _entry(other._entry) {
+            other._entry = emptyEntry();
+        }
+
+        InternedString &operator=(const InternedString &other) {
+            retain(other._entry);
+            release(_entry);
+            _entry = other._entry;
+            return *this;
+        }
+
+        InternedString &operator=(InternedString &&other) {
+            std::swap(_entry, other._entry);
+            return *this;
+        }
+
+        ~InternedString() {
+            release(_entry);
+        }
+
+        const std::string &str() const {
+            return _entry->value;
+        }
+
+        bool empty() const {
+            return _entry->value.empty();
+        }
+
+        bool operator==(const InternedString &other) const {
+            return _entry == other._entry;
+        }
+
+        bool operator!=(const InternedString &other) const {
+            return _entry != other._entry;
+        }
+
+        friend std::ostream &operator<<(std::ostream &out, const InternedString &s) {
+            return out << s._entry->value;
+        }
+
+        /**
+         * Hashes the handle, not the characters: equal strings share one copy.
+         */
+        struct Hash {
+            size_t operator()(const InternedString &s) const {
+                return std::hash<const void *>()(s._entry);
+            }
+        };
+
+    private:
+
+        static const size_t SHARDS = 16;
+        static const size_t MIN_SWEEP = 64; // entries a shard holds before it frees any
+
+        struct Entry {
+            Entry(const char *data, size_t size, size_t hash) :
+                    references{1}, isPermanent{false}, value(data, size), hash(hash) {
+            }
+
+            std::atomic<unsigned int> references;
+            std::atomic<bool> isPermanent; // never freed, so its handles don't count
+            const std::string value;
+            const size_t hash;
+        };
+
+        // a key views the characters of its own entry, so looking a string up needs no std::string.
+        struct Key {
+            const char *data;
+            size_t size;
+            size_t hash;
+        };
+
+        struct KeyHash {
+            size_t operator()(const Key &key) const {
+                return key.hash;
+            }
+        };
+
+        struct KeyEqual {
+            bool operator()(const Key &a, const Key &b) const {
+                return a.size == b.size && std::memcmp(a.data, b.data, a.size) == 0;
+            }
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<Key, Entry *, KeyHash, KeyEqual> entries;
+            size_t sweepAt = MIN_SWEEP; // the number of entries at which the ones without handles are freed
+
+            // called under the lock. An entry without handles can't get one meanwhile: only intern() revives
+            // one, and it takes the lock.
+            void sweep() {
+                for (auto i = entries.begin(); i != entries.end();) {
+                    Entry *entry = i->second;
+                    if (entry->references.load(std::memory_order_acquire) == 0) {
+                        i = entries.erase(i);
+                        delete entry;
+                    } else {
+                        ++i;
+                    }
+                }
+                sweepAt = entries.size() * 2 > MIN_SWEEP ? entries.size() * 2 : MIN_SWEEP;
+            }
+        };
+
+        static size_t hashOf(const char *data, size_t size) {
+            size_t hash = 2166136261u;
+            for (size_t i = 0; i < size; i++)
+                hash = (hash ^ (unsigned char) data[i]) * 16777619u;
+            return hash;
+        }
+
+        static Shard &shardOf(size_t hash) {
+            // never destroyed, so handles held by static objects stay valid during exit.
+            static Shard *shards = new Shard[SHARDS];
+            return shards[hash % SHARDS];
+        }
+
+        // the empty string is never freed, so default and moved from handles take no count.
+        static Entry *emptyEntry() {
+            static Entry *entry = intern("", 0, true);
+            return entry;
+        }
+
+        // a permanent entry keeps the reference it is returned with.
+        static Entry *intern(const char *data, size_t size, bool isPermanent = false) {
+            size_t hash = hashOf(data, size);
+            Shard &shard = shardOf(hash);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto i = shard.entries.find(Key{data, size, hash});
+            Entry *entry;
+            if (i != shard.entries.end()) {
+                entry = i->second;
+                retain(entry);
+            } else {
+                if (shard.entries.size() >= shard.sweepAt)
+                    shard.sweep();
+                entry = new Entry(data, size, hash);
+                shard.entries.emplace(Key{entry->value.data(), size, hash}, entry);
+            }
+            if (isPermanent)
+                entry->isPermanent.store(true, std::memory_order_relaxed);
+            return entry;
+        }
+
+        static void retain(Entry *entry) {
+            if (!entry->isPermanent.load(std::memory_order_relaxed))
+                entry->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // an entry left without handles is freed by the next sweep of its shard.
+        static void release(Entry *entry) {
+            if (!entry->isPermanent.load(std::memory_order_relaxed))
+                entry->references.fetch_sub(1, std::memory_order_release);
+        }
+
+        Entry *_entry;
+    };
+
+}
@@ -10,7 +10,9 @@
 #if defined (__GNUG__) || _MSC_VER >= 1900
 #define THROWS noexcept(false)
 #define NO_THROWS noexcept(true)
+#define THREAD_LOCAL thread_local
 #elif defined (_MSC_VER)
 #define THROWS throw(...)
 #define NO_THROWS
+#define THREAD_LOCAL __declspec(thread)
 #endif
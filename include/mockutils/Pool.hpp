@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <utility>
+
+namespace fakeit {
+
+    /**
+     * A bounded free list of released objects of a single kind.
+     * A released object is kept for the next acquire instead of being freed, so code that creates and destroys
+     * mocks of the same type in a loop stops allocating once the pool is warm. Acquire and release are thread
+     * safe. Pools are meant to be leaked statics, so objects released during exit still have a pool to go back to.
+     */
+    template<typename T>
+    class Pool {
+
+        static const size_t CAPACITY = 64;
+
+        std::mutex _mutex;
+        std::vector<T> _free;
+
+    public:
+
+        /**
+         * Move a pooled object into the argument. Returns false, leaving it as is, if the pool is empty.
+         */
+        bool acquire(T &into) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_free.empty())
+                return false;
+            into = std::move(_free.back());
+            _free.pop_back();
+            return true;
+        }
+
+        /**
+         * Move the argument into the pool. Returns false, leaving it to the caller to free, if the pool is full.
+         */
+        bool release(T &object) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_free.size() == CAPACITY)
+                return false;
+            _free.push_back(std::move(object));
+            return true;
+        }
+    };
+
+}
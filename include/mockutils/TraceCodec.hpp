@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "mockutils/type_utils.hpp"
+
+namespace fakeit {
+
+    /**
+     * The bytes of an invocation trace being written.
+     */
+    class TraceOutput {
+        std::vector<char> _bytes;
+
+    public:
+
+        void write(const void *data, size_t size) {
+            const char *bytes = static_cast<const char *>(data);
+            _bytes.insert(_bytes.end(), bytes, bytes + size);
+        }
+
+        void writeUInt(uint32_t value) {
+            write(&value, sizeof(value));
+        }
+
+        void writeString(const std::string &value) {
+            writeUInt((uint32_t) value.size());
+            write(value.data(), value.size());
+        }
+
+        /**
+         * Overwrite a value written before, at the given offset.
+         */
+        void patchUInt(size_t offset, uint32_t value) {
+            std::memcpy(&_bytes[offset], &value, sizeof(value));
+        }
+
+        size_t size() const {
+            return _bytes.size();
+        }
+
+        const char *data() const {
+            return _bytes.data();
+        }
+
+        /**
+         * Forget the bytes from the given offset on.
+         */
+        void truncate(size_t size) {
+            _bytes.resize(size);
+        }
+
+        /**
+         * Forget the bytes, keeping the storage.
+         */
+        void clear() {
+            _bytes.clear();
+        }
+    };
+
+    /**
+     * The bytes of one record of an invocation trace being read.
+     * Reading past the end throws std::runtime_error: the trace is truncated or was written by other code.
+     */
+    class TraceInput {
+        const char *_next;
+        const char *_end;
+
+    public:
+
+        TraceInput(const char *begin, const char *end) : _next(begin), _end(end) {
+        }
+
+        void read(void *into, size_t size) {
+            if ((size_t) (_end - _next) < size)
+                throw std::runtime_error("invocation trace record is shorter than its content");
+            std::memcpy(into, _next, size);
+            _next += size;
+        }
+
+        uint32_t readUInt() {
+            uint32_t value;
+            read(&value, sizeof(value));
+            return value;
+        }
+
+        std::string readString() {
+            uint32_t size = readUInt();
+            if ((size_t) (_end - _next) < size)
+                throw std::runtime_error("invocation trace record is shorter than its content");
+            std::string value(_next, size);
+            _next += size;
+            return value;
+        }
+
+        bool atEnd() const {
+            return _next == _end;
+        }
+    };
+
+    /**
+     * How an argument of type T is written to an invocation trace and read back.
+     * Arithmetic types, enums and std::string are supported. Specialize it for other types with:
+     *   static void write(TraceOutput &out, const T &value);
+     *   static T read(TraceInput &in);
+     * Traces are read back by the same build: values are written in the byte order of the machine.
+     */
+    template<typename T, class Enable = void>
+    struct TraceCodec {
+    };
+
+    template<typename T>
+    struct TraceCodec<T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type> {
+        static void write(TraceOutput &out, const T &value) {
+            out.write(&value, sizeof(T));
+        }
+
+        static T read(TraceInput &in) {
+            T value;
+            in.read(&value, sizeof(T));
+            return value;
+        }
+    };
+
+    template<>
+    struct TraceCodec<std::string> {
+        static void write(TraceOutput &out, const std::string &value) {
+            out.writeString(value);
+        }
+
+        static std::string read(TraceInput &in) {
+            return in.readString();
+        }
+    };
+
+    template<typename T, typename = void>
+    struct is_trace_serializable : std::false_type {
+    };
+
+    template<typename T>
+    struct is_trace_serializable<T, decltype((void) TraceCodec<T>::read(std::declval<TraceInput &>()))>
+            : std::true_type {
+    };
+
+    // helper function to write a tuple of Any size with the TraceCodec of its (naked) element types, in order.
+    template<class Tuple, std::size_t N>
+    struct TupleTraceWriter {
+        static void write(TraceOutput &out, const Tuple &t) {
+            typedef typename naked_type<typename std::tuple_element<N - 1, Tuple>::type>::type T;
+            TupleTraceWriter<Tuple, N - 1>::write(out, t);
+            TraceCodec<T>::write(out, std::get<N - 1>(t));
+        }
+    };
+
+    template<class Tuple>
+    struct TupleTraceWriter<Tuple, 0> {
+        static void write(TraceOutput &, const Tuple &) {
+        }
+    };
+}
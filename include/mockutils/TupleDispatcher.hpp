@@ -8,21 +8,23 @@
 #pragma once
 
 #include <tuple>
+#include <functional>
 
 namespace fakeit {
 
+    // The callable is passed by reference all the way down, so dispatching never copies it.
     template<int N>
     struct apply_func {
-        template<typename R, typename ... ArgsF, typename ... ArgsT, typename ... Args>
-        static R applyTuple(std::function<R(ArgsF &...)> f, std::tuple<ArgsT...> &t, Args &... args) {
-            return apply_func<N - 1>::template applyTuple(f, t, std::get<N - 1>(t), args...);
+        template<typename R, typename F, typename ... ArgsT, typename ... Args>
+        static R applyTuple(const F &f, std::tuple<ArgsT...> &t, Args &... args) {
+            return apply_func<N - 1>::template applyTuple<R>(f, t, std::get<N - 1>(t), args...);
         }
     };
 
     template<>
     struct apply_func < 0 > {
-        template<typename R, typename ... ArgsF, typename ... ArgsT, typename ... Args>
-        static R applyTuple(std::function<R(ArgsF &...)> f, std::tuple<ArgsT...> & /* t */, Args &... args) {
+        template<typename R, typename F, typename ... ArgsT, typename ... Args>
+        static R applyTuple(const F &f, std::tuple<ArgsT...> & /* t */, Args &... args) {
             return f(args...);
         }
     };
@@ -30,12 +32,12 @@ namespace fakeit {
     struct TupleDispatcher {
 
         template<typename R, typename ... ArgsF, typename ... ArgsT>
-        static R applyTuple(std::function<R(ArgsF &...)> f, std::tuple<ArgsT...> &t) {
-            return apply_func<sizeof...(ArgsT)>::template applyTuple(f, t);
+        static R applyTuple(const std::function<R(ArgsF &...)> &f, std::tuple<ArgsT...> &t) {
+            return apply_func<sizeof...(ArgsT)>::template applyTuple<R>(f, t);
         }
 
         template<typename R, typename ...arglist>
-        static R invoke(std::function<R(arglist &...)> func, const std::tuple<arglist...> &arguments) {
+        static R invoke(const std::function<R(arglist &...)> &func, const std::tuple<arglist...> &arguments) {
             std::tuple<arglist...> &args = const_cast<std::tuple<arglist...> &>(arguments);
             return applyTuple(func, args);
         }
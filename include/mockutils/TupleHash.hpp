@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+#pragma once
+
+#include <tuple>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "mockutils/type_utils.hpp"
+
+namespace fakeit {
+
+    template<typename T, typename = void>
+    struct is_hashable : std::false_type {
+    };
+
+    template<typename T>
+    struct is_hashable<T, decltype((void) std::hash<T>()(std::declval<const T &>()))> : std::true_type {
+    };
+
+    inline size_t combineHash(size_t seed, size_t hash) {
+        return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+
+    // helper function to hash a tuple of Any size with std::hash of its (naked) element types.
+    // The hash of N values is combineHash(<hash of the first N-1 values>, <hash of the last value>).
+    template<class Tuple, std::size_t N>
+    struct TupleHash {
+        static size_t hash(const Tuple &t) {
+            typedef typename naked_type<typename std::tuple_element<N - 1, Tuple>::type>::type T;
+            return combineHash(TupleHash<Tuple, N - 1>::hash(t), std::hash<T>()(std::get<N - 1>(t)));
+        }
+    };
+
+    template<class Tuple>
+    struct TupleHash<Tuple, 0> {
+        static size_t hash(const Tuple &) {
+            return 0;
+        }
+    };
+}
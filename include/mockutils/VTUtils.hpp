@@ -10,6 +10,7 @@
 
 #include <functional>
 #include <type_traits>
+#include <typeinfo>
 #include "mockutils/VirtualOffestSelector.hpp"
 #include "mockutils/union_cast.hpp"
 
@@ -27,9 +28,49 @@ namespace fakeit {
             return (offsetSelctor.*sMethod)(0);
         }
 
+        /**
+         * The virtual table layout of C. It never changes, so it is computed once, on first use.
+         */
+        template<typename C>
+        struct Metadata {
+            unsigned int size;
+            bool hasVirtualDtor;
+            unsigned int dtorOffset;
+            const std::type_info &typeInfo;
+
+            Metadata() :
+                    size(computeVTSize<C>()),
+                    hasVirtualDtor(std::has_virtual_destructor<C>::value),
+                    dtorOffset(computeDestructorOffset<C>()),
+                    typeInfo(typeid(C)) {
+            }
+        };
+
+        template<typename C>
+        static const Metadata<C> &getMetadata() {
+            static const Metadata<C> metadata;
+            return metadata;
+        }
+
+        template<typename C>
+        static unsigned int getDestructorOffset() {
+            const Metadata<C> &metadata = getMetadata<C>();
+            if (!metadata.hasVirtualDtor) {
+                throw NoVirtualDtor();
+            }
+            return metadata.dtorOffset;
+        }
+
+        template<typename C>
+        static unsigned int getVTSize() {
+            return getMetadata<C>().size;
+        }
+
+    private:
+
         template<typename C>
         static typename std::enable_if<std::has_virtual_destructor<C>::value, unsigned int>::type
-        getDestructorOffset() {
+        computeDestructorOffset() {
             VirtualOffsetSelector offsetSelctor;
             union_cast<C *>(&offsetSelctor)->~C();
             return offsetSelctor.offset;
@@ -37,12 +78,12 @@ namespace fakeit {
 
         template<typename C>
         static typename std::enable_if<!std::has_virtual_destructor<C>::value, unsigned int>::type
-        getDestructorOffset() {
-            throw NoVirtualDtor();
+        computeDestructorOffset() {
+            return 0;
         }
 
         template<typename C>
-        static unsigned int getVTSize() {
+        static unsigned int computeVTSize() {
             struct Derrived : public C {
                 virtual void endOfVt() {
                 }
@@ -13,6 +13,9 @@
 
 #endif
 
+#include <algorithm>
+#include "mockutils/Pool.hpp"
+
 namespace fakeit {
 
     struct VirtualTableBase {
@@ -89,7 +92,8 @@ namespace fakeit {
             _firstMethod--; // type_info
             _firstMethod--; // top_offset
             _firstMethod -= numOfCookies; // skip cookies
-            delete[] _firstMethod;
+            if (!arrayPool().release(_firstMethod))
+                delete[] _firstMethod;
         }
 
         unsigned int dtor(int) {
@@ -104,6 +108,15 @@ namespace fakeit {
         }
 
 
+        /**
+         * Undo setDtor.
+         */
+        void copyDtorFrom(VirtualTable<C, baseclasses...> &from) {
+            unsigned int index = VTUtils::getDestructorOffset<C>();
+            _firstMethod[index] = from.getMethod(index);
+            _firstMethod[index + 1] = from.getMethod(index + 1);
+        }
+
         void setDtor(void *method) {
             unsigned int index = VTUtils::getDestructorOffset<C>();
             void *dtorPtr = union_cast<void *>(&VirtualTable<C, baseclasses...>::dtor);
@@ -138,12 +151,22 @@ namespace fakeit {
     private:
         static const unsigned int numOfCookies = 2;
 
+        // arrays of disposed tables, they all have the size of the vtable of C.
+        static Pool<void **> &arrayPool() {
+            static Pool<void **> *pool = new Pool<void **>();
+            return *pool;
+        }
+
         static void **buildVTArray() {
             int size = VTUtils::getVTSize<C>();
-            auto array = new void *[size + 2 + numOfCookies]{};
+            void **array;
+            if (arrayPool().acquire(array))
+                std::fill(array, array + size + 2 + numOfCookies, nullptr);
+            else
+                array = new void *[size + 2 + numOfCookies]{};
             array += numOfCookies; // skip cookies
             array++; // skip top_offset
-            array[0] = const_cast<std::type_info *>(&typeid(C)); // type_info
+            array[0] = const_cast<std::type_info *>(&VTUtils::getMetadata<C>().typeInfo); // type_info
             array++; // skip type_info ptr
             return array;
         }
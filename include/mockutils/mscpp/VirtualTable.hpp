@@ -7,6 +7,9 @@
  */
 #pragma once
 
+#include <algorithm>
+#include "mockutils/Pool.hpp"
+
 namespace fakeit {
 
     typedef unsigned long DWORD;
@@ -206,7 +209,8 @@ namespace fakeit {
             RTTICompleteObjectLocator<C, baseclasses...> *locator = (RTTICompleteObjectLocator<C, baseclasses...> *) _firstMethod[0];
             delete locator;
             _firstMethod -= numOfCookies; // skip cookies
-            delete[] _firstMethod;
+            if (!arrayPool().release(_firstMethod))
+                delete[] _firstMethod;
         }
 
         // the dtor VC++ must of the format: int dtor(int)
@@ -220,6 +224,14 @@ namespace fakeit {
             return 0;
         }
 
+        /**
+         * Undo setDtor.
+         */
+        void copyDtorFrom(VirtualTable<C, baseclasses...> &from) {
+            unsigned int index = VTUtils::getDestructorOffset<C>();
+            _firstMethod[index] = from.getMethod(index);
+        }
+
         void setDtor(void *method) {
             // the dtor VC++ must of the format: int dtor(int).
             // the method passed by the user is: void dtor().
@@ -257,11 +269,21 @@ namespace fakeit {
             "Can't mock a type with multiple inheritance or with non-polymorphic base class");
         static const unsigned int numOfCookies = 3;
 
+        // arrays of disposed tables, they all have the size of the vtable of C.
+        static Pool<void **> &arrayPool() {
+            static Pool<void **> *pool = new Pool<void **>();
+            return *pool;
+        }
+
         static void **buildVTArray() {
             int vtSize = VTUtils::getVTSize<C>();
-            auto array = new void *[vtSize + numOfCookies + 1]{};
+            void **array;
+            if (arrayPool().acquire(array))
+                std::fill(array, array + vtSize + numOfCookies + 1, nullptr);
+            else
+                array = new void *[vtSize + numOfCookies + 1]{};
             RTTICompleteObjectLocator<C, baseclasses...> *objectLocator = new RTTICompleteObjectLocator<C, baseclasses...>(
-                    typeid(C));
+                    VTUtils::getMetadata<C>().typeInfo);
             array += numOfCookies; // skip cookies
             array[0] = objectLocator; // initialize RTTICompleteObjectLocator pointer
             array++; // skip object locator
@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <exception>
 #include "mockutils/Macros.hpp"
 
@@ -15,9 +16,14 @@ namespace fakeit {
 
     class RefCount {
     private:
-        int count;
+        // atomic, so that GCC doesn't assume the count of one owner may reach zero while another owner still
+        // holds it, and warn of a use after free (-Wuse-after-free) when both are destroyed in one function.
+        std::atomic<int> count;
 
     public:
+        RefCount() : count(0) {
+        }
+
         void AddRef() {
             count++;
         }
@@ -8,7 +8,9 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <tuple>
+#include <type_traits>
 
 
 namespace fakeit {
@@ -28,6 +30,26 @@ namespace fakeit {
     template<typename... arglist>
     using ArgumentsTuple = std::tuple < arglist... > ;
 
+    // the indices 0..N-1 of a tuple of N elements, to expand it into a pack.
+    template<std::size_t... indices>
+    struct tuple_indices {
+    };
+
+    template<std::size_t N, std::size_t... indices>
+    struct make_tuple_indices : make_tuple_indices<N - 1, N - 1, indices...> {
+    };
+
+    template<std::size_t... indices>
+    struct make_tuple_indices<0, indices...> {
+        typedef tuple_indices<indices...> type;
+    };
+
+    template<bool...>
+    struct bool_pack;
+
+    template<bool... values>
+    using all_true = std::is_same<bool_pack<true, values...>, bool_pack<values..., true>>;
+
     template< class T > struct test_arg         { typedef T& type; };
     template< class T > struct test_arg< T& >   { typedef T& type; };
     template< class T > struct test_arg< T&& >  { typedef T& type; };
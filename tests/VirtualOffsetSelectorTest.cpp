@@ -18,7 +18,8 @@ struct VirtualOffsetSelectorTest : tpunit::TestFixture {
     VirtualOffsetSelectorTest() :
             tpunit::TestFixture(
                     //
-                    TEST(VirtualOffsetSelectorTest::verifyAllIndexes)
+                    TEST(VirtualOffsetSelectorTest::verifyAllIndexes),
+                    TEST(VirtualOffsetSelectorTest::verifyVirtualTableMetadata)
                     //
             ) {
     }
@@ -1140,5 +1141,31 @@ struct VirtualOffsetSelectorTest : tpunit::TestFixture {
 
     }
 
+    struct WithVirtualDtor {
+        virtual ~WithVirtualDtor() = default;
+
+        virtual void a() = 0;
+
+        virtual void b() = 0;
+    };
+
+    struct WithoutVirtualDtor {
+        virtual void a() = 0;
+    };
+
+    void verifyVirtualTableMetadata() {
+        const VTUtils::Metadata<WithVirtualDtor> &metadata = VTUtils::getMetadata<WithVirtualDtor>();
+        ASSERT_EQUAL(&metadata, &VTUtils::getMetadata<WithVirtualDtor>());
+        ASSERT_TRUE(metadata.typeInfo == typeid(WithVirtualDtor));
+        ASSERT_TRUE(metadata.hasVirtualDtor);
+        ASSERT_EQUAL(metadata.size, VTUtils::getVTSize<WithVirtualDtor>());
+        ASSERT_EQUAL(VTUtils::getOffset(&WithVirtualDtor::b) + 1, VTUtils::getVTSize<WithVirtualDtor>());
+        ASSERT_EQUAL(metadata.dtorOffset, VTUtils::getDestructorOffset<WithVirtualDtor>());
+
+        ASSERT_EQUAL(1u, VTUtils::getVTSize<WithoutVirtualDtor>());
+        ASSERT_FALSE(VTUtils::getMetadata<WithoutVirtualDtor>().hasVirtualDtor);
+        ASSERT_THROW(VTUtils::getDestructorOffset<WithoutVirtualDtor>(), NoVirtualDtor);
+    }
+
 } __VirtualOffsetSelector;
 
@@ -28,7 +28,12 @@ struct ArgumentMatchingTests: tpunit::TestFixture {
 					TEST(ArgumentMatchingTests::test_any_matcher), TEST(ArgumentMatchingTests::format_Lt),
 					TEST(ArgumentMatchingTests::test_any_matcher), TEST(ArgumentMatchingTests::format_Le),
 					TEST(ArgumentMatchingTests::test_any_matcher), TEST(ArgumentMatchingTests::format_Ne),
-                    TEST(ArgumentMatchingTests::mixed_matchers)
+                    TEST(ArgumentMatchingTests::mixed_matchers),
+                    TEST(ArgumentMatchingTests::user_defined_matcher_creator),
+                    TEST(ArgumentMatchingTests::format_multiple_matchers),
+                    TEST(ArgumentMatchingTests::last_registered_clause_wins_over_equal_values_clauses),
+                    TEST(ArgumentMatchingTests::many_equal_values_clauses),
+                    TEST(ArgumentMatchingTests::equal_values_clauses_of_unhashable_type)
 			) //
 	{
 	}
@@ -314,5 +319,116 @@ struct ArgumentMatchingTests: tpunit::TestFixture {
 			ASSERT_EQUAL(expectedMsg, actualMsg);
 		}
 	}
+
+	struct IsEven : TypedMatcherCreator<int> {
+		struct Matcher : TypedMatcher<int> {
+			virtual bool matches(const int &actual) const override {
+				return actual % 2 == 0;
+			}
+
+			virtual std::string format() const override {
+				return "even";
+			}
+		};
+
+		virtual TypedMatcher<int> *createMatcher() const override {
+			return new Matcher();
+		}
+	};
+
+	void user_defined_matcher_creator() {
+		Mock<SomeInterface> mock;
+		When(Method(mock, func)).Return(0);
+		When(Method(mock, func).Using(IsEven())).Return(1);
+		When(Method(mock, func2).Using(IsEven(), "x")).AlwaysReturn(2);
+		SomeInterface &i = mock.get();
+		ASSERT_EQUAL(1, i.func(2));
+		ASSERT_EQUAL(0, i.func(3));
+		ASSERT_EQUAL(2, i.func2(4, "x"));
+		ASSERT_THROW(i.func2(4, "y"), fakeit::UnexpectedMethodCallException);
+		ASSERT_THROW(i.func2(5, "x"), fakeit::UnexpectedMethodCallException);
+		try {
+			fakeit::Verify(Method(mock, func2).Using(IsEven(), _)).setFileInfo("test file", 1, "test method").Never();
+		} catch (SequenceVerificationException& e) {
+			std::string actualMsg { to_string(e) };
+			ASSERT_TRUE(actualMsg.find("Expected pattern: mock.func2(even, Any)\n") != std::string::npos);
+			return;
+		}
+		FAIL();
+	}
+
+	void format_multiple_matchers() {
+		Mock<SomeInterface> mock;
+		try {
+			fakeit::Verify(Method(mock, func2).Using(Gt(1), _)).setFileInfo("test file", 1, "test method").Exactly(Once);
+		} catch (SequenceVerificationException& e) {
+			std::string expectedMsg{ formatLineNumner("test file", 1) };
+			expectedMsg += ": Verification error\n";
+			expectedMsg += "Expected pattern: mock.func2(>1, Any)\n";
+			expectedMsg += "Expected matches: exactly 1\n";
+			expectedMsg += "Actual matches  : 0\n";
+			expectedMsg += "Actual sequence : total of 0 actual invocations.";
+			std::string actualMsg { to_string(e) };
+			ASSERT_EQUAL(expectedMsg, actualMsg);
+			return;
+		}
+		FAIL();
+	}
+
+	void last_registered_clause_wins_over_equal_values_clauses() {
+		Mock<SomeInterface> mock;
+		SomeInterface &i = mock.get();
+		When(Method(mock, func2).Using(1, "a")).AlwaysReturn(1);
+		ASSERT_EQUAL(1, i.func2(1, "a"));
+		When(Method(mock, func2)).AlwaysReturn(0);
+		ASSERT_EQUAL(0, i.func2(1, "a"));
+		When(Method(mock, func2).Using(1, "a")).AlwaysReturn(2);
+		When(Method(mock, func2).Using(2, "a")).AlwaysReturn(3);
+		ASSERT_EQUAL(2, i.func2(1, "a"));
+		ASSERT_EQUAL(3, i.func2(2, "a"));
+		ASSERT_EQUAL(0, i.func2(1, "b"));
+		When(Method(mock, func2).Using(Gt(1), "a")).AlwaysReturn(4);
+		ASSERT_EQUAL(2, i.func2(1, "a"));
+		ASSERT_EQUAL(4, i.func2(2, "a"));
+		When(Method(mock, func2).Using(2, "a")).Return(5);
+		ASSERT_EQUAL(5, i.func2(2, "a"));
+		ASSERT_THROW(i.func2(2, "a"), fakeit::UnexpectedMethodCallException);
+	}
+
+	void many_equal_values_clauses() {
+		Mock<SomeInterface> mock;
+		for (int key = 0; key < 1000; key++) {
+			When(Method(mock, func).Using(key)).AlwaysReturn(key * 2);
+		}
+		SomeInterface &i = mock.get();
+		for (int key = 0; key < 1000; key++) {
+			ASSERT_EQUAL(key * 2, i.func(key));
+		}
+		ASSERT_THROW(i.func(1000), fakeit::UnexpectedMethodCallException);
+		Verify(Method(mock, func).Using(500)).Once();
+	}
+
+	struct Point {
+		int x;
+		int y;
+
+		bool operator==(const Point &other) const {
+			return x == other.x && y == other.y;
+		}
+	};
+
+	struct PointConsumer {
+		virtual int use(Point) = 0;
+	};
+
+	void equal_values_clauses_of_unhashable_type() {
+		Mock<PointConsumer> mock;
+		When(Method(mock, use).Using(Point{1, 2})).AlwaysReturn(1);
+		When(Method(mock, use).Using(Point{3, 4})).AlwaysReturn(2);
+		PointConsumer &i = mock.get();
+		ASSERT_EQUAL(1, i.use(Point{1, 2}));
+		ASSERT_EQUAL(2, i.use(Point{3, 4}));
+		ASSERT_THROW(i.use(Point{1, 4}), fakeit::UnexpectedMethodCallException);
+	}
 } __ArgumentMatching;
 
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct ArgumentsCaptureTests : tpunit::TestFixture {
+    ArgumentsCaptureTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(ArgumentsCaptureTests::arguments_passed_by_value_are_not_copied),//
+                    TEST(ArgumentsCaptureTests::stubs_see_arguments_captured_by_reference),//
+                    TEST(ArgumentsCaptureTests::verify_arguments_captured_by_reference),//
+                    TEST(ArgumentsCaptureTests::verify_arguments_captured_by_fingerprint),//
+                    TEST(ArgumentsCaptureTests::fingerprint_of_unhashable_arguments_should_throw_invalid_argument),//
+                    TEST(ArgumentsCaptureTests::format_invocations_with_released_arguments),//
+                    TEST(ArgumentsCaptureTests::reset_captures_arguments_by_value)
+            ) {
+    }
+
+    struct Payload {
+        static int copies;
+
+        Payload() = default;
+
+        Payload(const Payload &) {
+            copies++;
+        }
+
+        Payload(Payload &&) = default;
+    };
+
+    struct Unhashable {
+        bool operator==(const Unhashable &) const {
+            return true;
+        }
+    };
+
+    struct Bus {
+        virtual bool send(std::string) = 0;
+
+        virtual void consume(Payload) = 0;
+
+        virtual void post(Unhashable) = 0;
+    };
+
+    template<typename T>
+    std::string to_string(T &val) {
+        std::stringstream stream;
+        stream << val;
+        return stream.str();
+    }
+
+    void arguments_passed_by_value_are_not_copied() {
+        Mock<Bus> mock;
+        Fake(Method(mock, consume));
+        Payload payload;
+        Payload::copies = 0;
+        mock.get().consume(payload);
+        ASSERT_EQUAL(1, Payload::copies); // by the caller, into the parameter
+        Verify(Method(mock, consume)).Once();
+    }
+
+    void stubs_see_arguments_captured_by_reference() {
+        Mock<Bus> mock;
+        std::string last;
+        When(Method(mock, send).Capture(ArgumentsCapture::ByReference).Using("a")).AlwaysReturn(true);
+        When(Method(mock, send).Using("b")).AlwaysDo([&](std::string &s) {
+            last = s;
+            return false;
+        });
+        Bus &i = mock.get();
+        ASSERT_TRUE(i.send("a"));
+        ASSERT_FALSE(i.send("b"));
+        ASSERT_EQUAL(std::string("b"), last);
+        ASSERT_THROW(i.send("c"), fakeit::UnexpectedMethodCallException);
+    }
+
+    void verify_arguments_captured_by_reference() {
+        Mock<Bus> mock;
+        When(Method(mock, send).Capture(ArgumentsCapture::ByReference)).AlwaysReturn(true);
+        Bus &i = mock.get();
+        i.send("a");
+        i.send("b");
+        Verify(Method(mock, send)).Exactly(2);
+        ASSERT_THROW(Verify(Method(mock, send).Using("a")), std::invalid_argument);
+        ASSERT_THROW(Verify(Method(mock, send).Matching([](std::string &) { return true; })), std::invalid_argument);
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void verify_arguments_captured_by_fingerprint() {
+        Mock<Bus> mock;
+        Method(mock, send).Capture(ArgumentsCapture::ByFingerprint);
+        When(Method(mock, send)).AlwaysReturn(true);
+        Bus &i = mock.get();
+        i.send("a");
+        i.send("b");
+        i.send("a");
+        Verify(Method(mock, send)).Exactly(3);
+        Verify(Method(mock, send).Using("a")).Twice();
+        Verify(Method(mock, send).Using(Eq<std::string>("b"))).Once();
+        Verify(Method(mock, send).Using("c")).Never();
+        Verify(Method(mock, send).Using("a"), Method(mock, send).Using("b"));
+        ASSERT_THROW(Verify(Method(mock, send).Using(Ne<std::string>("a"))), std::invalid_argument);
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void fingerprint_of_unhashable_arguments_should_throw_invalid_argument() {
+        Mock<Bus> mock;
+        ASSERT_THROW(Method(mock, post).Capture(ArgumentsCapture::ByFingerprint), std::invalid_argument);
+        Method(mock, post).Capture(ArgumentsCapture::ByReference);
+    }
+
+    void format_invocations_with_released_arguments() {
+        Mock<Bus> mock;
+        When(Method(mock, send).Capture(ArgumentsCapture::ByReference)).AlwaysReturn(true);
+        Bus &i = mock.get();
+        i.send("a");
+        try {
+            VerifyNoOtherInvocations(mock);
+            FAIL();
+        } catch (NoMoreInvocationsVerificationException &e) {
+            std::string actual{to_string(e)};
+            ASSERT_TRUE(actual.find("mock.send(<not captured>)") != std::string::npos);
+        }
+    }
+
+    void reset_captures_arguments_by_value() {
+        Mock<Bus> mock;
+        When(Method(mock, send).Capture(ArgumentsCapture::ByReference)).AlwaysReturn(true);
+        mock.Reset();
+        When(Method(mock, send)).AlwaysReturn(true);
+        mock.get().send("a");
+        Verify(Method(mock, send).Using("a")).Once();
+    }
+
+} __ArgumentsCaptureTests;
+
+int ArgumentsCaptureTests::Payload::copies = 0;
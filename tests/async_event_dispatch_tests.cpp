@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <stdexcept>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct AsyncEventDispatchTests : tpunit::TestFixture {
+    AsyncEventDispatchTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(AsyncEventDispatchTests::listeners_are_called_on_another_thread),//
+                    TEST(AsyncEventDispatchTests::destroying_a_mock_waits_for_its_events),//
+                    TEST(AsyncEventDispatchTests::events_go_to_the_listeners_at_the_time_of_the_call),//
+                    TEST(AsyncEventDispatchTests::full_queue_delays_events_without_losing_them),//
+                    TEST(AsyncEventDispatchTests::listener_exception_is_rethrown_by_flush),//
+                    TEST(AsyncEventDispatchTests::verification_failure_waits_for_queued_events),//
+                    TEST(AsyncEventDispatchTests::passing_verification_rethrows_listener_exception),//
+                    TEST(AsyncEventDispatchTests::disable_dispatches_synchronously_again)
+            ) {
+    }
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+    };
+
+    // Not thread safe: in async mode it is only called by the dispatcher thread.
+    class RecordingListener : public EventHandler {
+    public:
+        std::vector<std::string> events;
+        std::vector<std::thread::id> threads;
+        std::mutex *gate = nullptr;
+        bool throws = false;
+
+        void handle(const UnexpectedMethodCallEvent &e) override {
+            if (gate) { // wait until the test opens it
+                gate->lock();
+                gate->unlock();
+            }
+            events.push_back(e.getInvocation().format());
+            threads.push_back(std::this_thread::get_id());
+            if (throws)
+                throw std::runtime_error("listener failed");
+        }
+
+        void handle(const SequenceVerificationEvent &) override {
+            events.push_back("verification");
+            threads.push_back(std::this_thread::get_id());
+        }
+
+        void handle(const NoMoreInvocationsVerificationEvent &) override {
+            events.push_back("no more invocations");
+            threads.push_back(std::this_thread::get_id());
+        }
+    };
+
+    static void teardown() {
+        Fakeit.disableAsyncEventDispatch();
+        Fakeit.clearEventHandlers();
+    }
+
+    void listeners_are_called_on_another_thread() {
+        RecordingListener listener;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock;
+        When(Method(mock, func).Using(0)).Return(0);
+        ASSERT_THROW(mock.get().func(1), fakeit::UnexpectedMethodCallException);
+        Fakeit.flushEvents();
+        ASSERT_EQUAL(1, (int) listener.events.size());
+        ASSERT_EQUAL(std::string("mock.func(1)"), listener.events[0]);
+        ASSERT_TRUE(listener.threads[0] != std::this_thread::get_id());
+    }
+
+    void destroying_a_mock_waits_for_its_events() {
+        RecordingListener listener;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        {
+            Mock<SomeInterface> mock;
+            When(Method(mock, func).Using(1)).Return(1);
+            ASSERT_THROW(mock.get().func(2), fakeit::UnexpectedMethodCallException);
+        }
+        ASSERT_EQUAL(1, (int) listener.events.size());
+        ASSERT_EQUAL(std::string("mock.func(2)"), listener.events[0]);
+    }
+
+    void events_go_to_the_listeners_at_the_time_of_the_call() {
+        RecordingListener before;
+        RecordingListener after;
+        std::mutex gate;
+        before.gate = &gate;
+        Fakeit.addEventHandler(before);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock;
+        {
+            std::lock_guard<std::mutex> closed(gate);
+            ASSERT_THROW(mock.get().func(1), fakeit::UnexpectedMethodCallException);
+            Fakeit.addEventHandler(after); // while the event waits for the gate
+        }
+        Fakeit.flushEvents();
+        ASSERT_EQUAL(1, (int) before.events.size());
+        ASSERT_EQUAL(0, (int) after.events.size());
+    }
+
+    void full_queue_delays_events_without_losing_them() {
+        RecordingListener listener;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch(2);
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock(ThreadSafe);
+        SomeInterface &i = mock.get();
+        When(Method(mock, func).Using(0)).AlwaysReturn(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&i]() {
+                for (int n = 1; n <= 50; n++) {
+                    try {
+                        i.func(n);
+                    } catch (fakeit::UnexpectedMethodCallException &) {
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        Fakeit.flushEvents();
+        ASSERT_EQUAL(200, (int) listener.events.size());
+    }
+
+    void listener_exception_is_rethrown_by_flush() {
+        RecordingListener listener;
+        listener.throws = true;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock;
+        ASSERT_THROW(mock.get().func(1), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(mock.get().func(2), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(Fakeit.flushEvents(), std::runtime_error);
+        ASSERT_EQUAL(2, (int) listener.events.size());
+        Fakeit.flushEvents(); // reported once
+    }
+
+    void verification_failure_waits_for_queued_events() {
+        RecordingListener listener;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock;
+        When(Method(mock, func).Using(0)).Return(0);
+        ASSERT_THROW(mock.get().func(1), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(Verify(Method(mock, func)), fakeit::SequenceVerificationException);
+        ASSERT_EQUAL(2, (int) listener.events.size());
+        ASSERT_EQUAL(std::string("mock.func(1)"), listener.events[0]);
+        ASSERT_EQUAL(std::string("verification"), listener.events[1]);
+        ASSERT_TRUE(listener.threads[1] == std::this_thread::get_id());
+    }
+
+    void passing_verification_rethrows_listener_exception() {
+        RecordingListener listener;
+        listener.throws = true;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock;
+        When(Method(mock, func).Using(0)).AlwaysReturn(0);
+        mock.get().func(0);
+        ASSERT_THROW(mock.get().func(1), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(Verify(Method(mock, func).Using(0)), std::runtime_error);
+        Verify(Method(mock, func).Using(0)).Once();
+    }
+
+    void disable_dispatches_synchronously_again() {
+        RecordingListener listener;
+        Fakeit.addEventHandler(listener);
+        Fakeit.enableAsyncEventDispatch();
+        Finally onExit(teardown);
+        Mock<SomeInterface> mock;
+        ASSERT_THROW(mock.get().func(1), fakeit::UnexpectedMethodCallException);
+        Fakeit.disableAsyncEventDispatch();
+        ASSERT_EQUAL(1, (int) listener.events.size());
+        ASSERT_THROW(mock.get().func(2), fakeit::UnexpectedMethodCallException);
+        ASSERT_EQUAL(2, (int) listener.events.size());
+        ASSERT_TRUE(listener.threads[1] == std::this_thread::get_id());
+    }
+
+} __AsyncEventDispatchTests;
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <stdexcept>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct BoundedHistoryTests : tpunit::TestFixture {
+    BoundedHistoryTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(BoundedHistoryTests::count_dropped_invocations),//
+                    TEST(BoundedHistoryTests::verify_retained_invocations_with_matcher),//
+                    TEST(BoundedHistoryTests::verify_sequence_in_retained_invocations),//
+                    TEST(BoundedHistoryTests::throw_if_pattern_is_outside_retained_invocations),//
+                    TEST(BoundedHistoryTests::verify_no_other_invocations_after_invocations_were_dropped),//
+                    TEST(BoundedHistoryTests::verify_no_other_invocations_throws_while_dropped_invocations_are_unverified),//
+                    TEST(BoundedHistoryTests::keep_last_zero_is_rejected),//
+                    TEST(BoundedHistoryTests::check_throws_usage_error_every_time),//
+                    TEST(BoundedHistoryTests::keep_arguments_of_recursive_calls),//
+                    TEST(BoundedHistoryTests::reset_clears_counters)
+            ) {
+    }
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+
+        virtual void proc(int) = 0;
+    };
+
+    void count_dropped_invocations() {
+        Mock<SomeInterface> mock(KeepLast(3));
+        Fake(Method(mock, func));
+        SomeInterface &i = mock.get();
+        for (int n = 0; n < 10; n++) {
+            i.func(n);
+        }
+        Verify(Method(mock, func)).Exactly(10);
+        Verify(Method(mock, func)).AtLeast(5);
+        Verify(Method(mock, proc)).Never();
+        ASSERT_THROW(Verify(Method(mock, func)).Exactly(9), fakeit::VerificationException);
+        ASSERT_THROW(Verify(Method(mock, func)).AtLeast(11), fakeit::VerificationException);
+    }
+
+    void verify_retained_invocations_with_matcher() {
+        Mock<SomeInterface> mock(KeepLast(3));
+        Fake(Method(mock, func));
+        SomeInterface &i = mock.get();
+        for (int n = 0; n < 10; n++) {
+            i.func(n);
+        }
+        Verify(Method(mock, func).Using(9));
+        Verify(Method(mock, func).Matching([](int a) { return a > 6; })).AtLeast(3);
+        ASSERT_THROW(Verify(Method(mock, func).Using(7)).Never(), fakeit::VerificationException);
+    }
+
+    void verify_sequence_in_retained_invocations() {
+        Mock<SomeInterface> mock(KeepLast(2));
+        Fake(Method(mock, func), Method(mock, proc));
+        SomeInterface &i = mock.get();
+        for (int n = 0; n < 5; n++) {
+            i.func(n);
+            i.proc(n);
+        }
+        Verify(Method(mock, func).Using(3), Method(mock, proc).Using(3), Method(mock, func).Using(4));
+        Verify(Method(mock, func).Using(4) + Method(mock, proc).Using(4));
+    }
+
+    void throw_if_pattern_is_outside_retained_invocations() {
+        Mock<SomeInterface> mock(KeepLast(3));
+        Fake(Method(mock, func));
+        SomeInterface &i = mock.get();
+        for (int n = 0; n < 10; n++) {
+            i.func(n);
+        }
+        ASSERT_THROW(Verify(Method(mock, func).Using(1)), std::invalid_argument);
+        ASSERT_THROW(Verify(Method(mock, func).Using(9)).Exactly(1), std::invalid_argument);
+        ASSERT_THROW(Verify(Method(mock, func).Using(1)).Never(), std::invalid_argument);
+        ASSERT_THROW(Verify(Method(mock, func) * 5), std::invalid_argument);
+    }
+
+    void verify_no_other_invocations_after_invocations_were_dropped() {
+        Mock<SomeInterface> mock(KeepLast(2));
+        Fake(Method(mock, func));
+        SomeInterface &i = mock.get();
+        i.func(1);
+        i.func(2);
+        Verify(Method(mock, func)).Twice();
+        VerifyNoOtherInvocations(mock);
+        i.func(3);
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::VerificationException);
+        Verify(Method(mock, func)).Exactly(3);
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void verify_no_other_invocations_throws_while_dropped_invocations_are_unverified() {
+        Mock<SomeInterface> mock(KeepLast(1));
+        Fake(Method(mock, func), Method(mock, proc));
+        SomeInterface &i = mock.get();
+        i.func(1);
+        i.func(2);
+        i.proc(1);
+        Verify(Method(mock, func).Using(2));
+        Verify(Method(mock, proc)).Once();
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), std::invalid_argument);
+        Verify(Method(mock, func)).AtLeastOnce();
+        VerifyNoOtherInvocations(mock);
+        i.func(3);
+        i.func(4);
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::VerificationException);
+        Verify(Method(mock, func).Using(4));
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), std::invalid_argument);
+    }
+
+    void keep_last_zero_is_rejected() {
+        ASSERT_THROW(KeepLast(0), std::invalid_argument);
+    }
+
+    void check_throws_usage_error_every_time() {
+        Mock<SomeInterface> mock(KeepLast(1));
+        Fake(Method(mock, func));
+        mock.get().func(1);
+        mock.get().func(2);
+        auto call = Method(mock, func).Using(1);
+        auto verification = Verify(call);
+        ASSERT_THROW(verification.Check(), std::invalid_argument);
+        ASSERT_THROW(verification.Check(), std::invalid_argument);
+        Verify(Method(mock, func).Using(2));
+        auto noOtherInvocations = VerifyNoOtherInvocations(mock);
+        ASSERT_THROW(noOtherInvocations.Check(), std::invalid_argument);
+        ASSERT_THROW(noOtherInvocations.Check(), std::invalid_argument);
+    }
+
+    void keep_arguments_of_recursive_calls() {
+        Mock<SomeInterface> mock(KeepLast(1));
+        SomeInterface &i = mock.get();
+        When(Method(mock, func)).AlwaysDo([&](int &a) {
+            if (a == 0)
+                return 0;
+            return i.func(a - 1) + a;
+        });
+        ASSERT_EQUAL(15, i.func(5));
+        Verify(Method(mock, func)).Exactly(6);
+        Verify(Method(mock, func).Using(0));
+        ASSERT_THROW(Verify(Method(mock, func).Using(5)), std::invalid_argument);
+    }
+
+    void reset_clears_counters() {
+        Mock<SomeInterface> mock(KeepLast(1));
+        Fake(Method(mock, func));
+        mock.get().func(1);
+        mock.get().func(2);
+        mock.Reset();
+        Fake(Method(mock, func));
+        mock.get().func(3);
+        Verify(Method(mock, func)).Once();
+        Verify(Method(mock, func).Using(3)).Once();
+        VerifyNoOtherInvocations(mock);
+    }
+
+} __BoundedHistoryTests;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct CallStatisticsTests : tpunit::TestFixture {
+    CallStatisticsTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(CallStatisticsTests::count_matched_and_unmatched_calls),//
+                    TEST(CallStatisticsTests::count_bytes_of_captured_arguments),//
+                    TEST(CallStatisticsTests::statistics_outlive_the_mock),//
+                    TEST(CallStatisticsTests::statistics_are_kept_on_reset),//
+                    TEST(CallStatisticsTests::clear_forgets_statistics),//
+                    TEST(CallStatisticsTests::dump_lists_called_methods)
+            ) {
+    }
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+
+        virtual void proc(int) = 0;
+    };
+
+    static MethodStatistics statisticsOf(const std::string &name) {
+        for (const MethodStatistics &method : Fakeit.getMethodStatistics()) {
+            if (method.name == name)
+                return method;
+        }
+        return MethodStatistics();
+    }
+
+    void count_matched_and_unmatched_calls() {
+        Fakeit.clearMethodStatistics();
+        Mock<SomeInterface> counted;
+        When(Method(counted, func).Using(1)).Return(1);
+        SomeInterface &i = counted.get();
+        i.func(1);
+        ASSERT_THROW(i.func(2), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(i.func(1), fakeit::UnexpectedMethodCallException); // no action left
+        MethodStatistics func = statisticsOf("counted.func");
+        ASSERT_EQUAL(3ull, func.calls);
+        ASSERT_EQUAL(1ull, func.matchedCalls());
+        ASSERT_EQUAL(2ull, func.unmatchedCalls);
+        ASSERT_EQUAL(0ull, statisticsOf("counted.proc").calls);
+    }
+
+    void count_bytes_of_captured_arguments() {
+        Fakeit.clearMethodStatistics();
+        Mock<SomeInterface> captured;
+        Fake(Method(captured, proc));
+        When(Method(captured, func).Capture(ArgumentsCapture::ByReference)).AlwaysReturn(0);
+        SomeInterface &i = captured.get();
+        i.proc(1);
+        i.proc(2);
+        i.func(1);
+        ASSERT_EQUAL(2 * sizeof(std::tuple<int>), (size_t) statisticsOf("captured.proc").capturedArgumentBytes);
+        ASSERT_EQUAL(0ull, statisticsOf("captured.func").capturedArgumentBytes);
+    }
+
+    void statistics_outlive_the_mock() {
+        Fakeit.clearMethodStatistics();
+        for (int n = 0; n < 2; n++) {
+            Mock<SomeInterface> destroyed;
+            Fake(Method(destroyed, proc));
+            destroyed.get().proc(1);
+        }
+        ASSERT_EQUAL(2ull, statisticsOf("destroyed.proc").calls);
+    }
+
+    void statistics_are_kept_on_reset() {
+        Fakeit.clearMethodStatistics();
+        Mock<SomeInterface> reset;
+        Fake(Method(reset, proc));
+        reset.get().proc(1);
+        reset.Reset();
+        Fake(Method(reset, proc));
+        reset.get().proc(1);
+        ASSERT_EQUAL(2ull, statisticsOf("reset.proc").calls);
+    }
+
+    void clear_forgets_statistics() {
+        Mock<SomeInterface> cleared;
+        Fake(Method(cleared, proc));
+        cleared.get().proc(1);
+        Fakeit.clearMethodStatistics();
+        ASSERT_EQUAL(0ull, statisticsOf("cleared.proc").calls);
+        cleared.get().proc(1);
+        ASSERT_EQUAL(1ull, statisticsOf("cleared.proc").calls);
+    }
+
+    void dump_lists_called_methods() {
+        Fakeit.clearMethodStatistics();
+        Mock<SomeInterface> dumped;
+        Fake(Method(dumped, proc), Method(dumped, func));
+        dumped.get().proc(1);
+        std::ostringstream out;
+        Fakeit.dumpMethodStatistics(out);
+        ASSERT_TRUE(out.str().find("dumped.proc") != std::string::npos);
+        ASSERT_TRUE(out.str().find("dumped.func") == std::string::npos);
+    }
+
+} __CallStatisticsTests;
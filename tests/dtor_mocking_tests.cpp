@@ -22,7 +22,8 @@ struct DtorMocking : tpunit::TestFixture
             TEST(DtorMocking::mock_virtual_dtor_by_assignment),
             TEST(DtorMocking::call_dtor_without_delete),
             TEST(DtorMocking::spy_dtor),
-			TEST(DtorMocking::production_takes_ownwership_with_uniqe_ptr)//
+			TEST(DtorMocking::production_takes_ownwership_with_uniqe_ptr),
+			TEST(DtorMocking::mock_dtor_declared_after_other_methods)//
 		)
 	{
 	}
@@ -94,4 +95,21 @@ struct DtorMocking : tpunit::TestFixture
 		ASSERT_THROW(Verify(Dtor(mock)).Once(), fakeit::VerificationException);
     }
 
+    struct DtorIsNotFirst {
+        virtual int foo() = 0;
+        virtual ~DtorIsNotFirst() = default;
+    };
+
+    void mock_dtor_declared_after_other_methods() {
+        Mock<DtorIsNotFirst> mock;
+        Fake(Dtor(mock));
+        DtorIsNotFirst * i = &mock.get();
+        delete i;
+        Verify(Dtor(mock)).Once();
+        When(Method(mock, foo)).Return(1);
+        ASSERT_EQUAL(1, i->foo());
+        delete i;
+        Verify(Dtor(mock)).Twice();
+    }
+
 } __DtorMocking;
@@ -23,6 +23,8 @@ struct EventNotification: tpunit::TestFixture {
 					TEST(EventNotification::handle_UnexpectedMethodCallEvent),
 					TEST(EventNotification::handle_SequenceVerificationEvent),
 					TEST(EventNotification::handle_NoMoreInvocationsVerificationEvent),
+					TEST(EventNotification::failed_check_should_not_notify_listeners),
+					TEST(EventNotification::listener_may_call_the_mock_that_raised_the_event),
 					TEST(
 							EventNotification::ShouldThrow_UnexpectedMethodCallException_IfAdapterDidNotThrowException_WhenHandlingAnUnmatchedInvocation),
 					TEST(
@@ -82,6 +84,25 @@ struct EventNotification: tpunit::TestFixture {
 		virtual int func(int) = 0;
 	};
 
+	// Calls the mock back once, from the first unexpected call event.
+	class CallingBackEventHandler: public fakeit::EventHandler {
+	public:
+		SomeInterface *calledBack = nullptr;
+
+		virtual void handle(const UnexpectedMethodCallEvent&) {
+			SomeInterface *i = calledBack;
+			calledBack = nullptr;
+			if (i)
+				i->func(1);
+		}
+
+		virtual void handle(const SequenceVerificationEvent&) {
+		}
+
+		virtual void handle(const NoMoreInvocationsVerificationEvent&) {
+		}
+	};
+
 	class finally {
 	private:
 		std::function<void()> finallyClause;
@@ -151,6 +172,34 @@ struct EventNotification: tpunit::TestFixture {
 		}
 	}
 
+	void failed_check_should_not_notify_listeners() {
+		setup();
+		finally onExit(teardown);
+		Mock<SomeInterface> mock;
+		Fake(Method(mock, func));
+		mock.get().func(1);
+		ASSERT_FALSE(fakeit::Verify(Method(mock, func).Using(2)).Check());
+		ASSERT_FALSE(fakeit::Verify(Method(mock, func)).Twice().Check());
+		ASSERT_FALSE(fakeit::VerifyNoOtherInvocations(Method(mock, func)).Check());
+		ASSERT_FALSE(fakeit::Verify(Method(mock, func).Using(2)));
+		ASSERT_FALSE(fakeit::VerifyNoOtherInvocations(Method(mock, func)));
+	}
+
+	void listener_may_call_the_mock_that_raised_the_event() {
+		CallingBackEventHandler listener;
+		Fakeit.addEventHandler(listener);
+		finally onExit(teardown);
+		Mock<SomeInterface> mock;
+		Fake(Method(mock, func).Using(1));
+		SomeInterface &i = mock.get();
+		i.func(1);
+		listener.calledBack = &i;
+		ASSERT_THROW(i.func(2), fakeit::UnexpectedMethodCallException);
+		// the unmatched call is dropped from the log, not the matched one made by the listener after it.
+		fakeit::Verify(Method(mock, func).Using(1)).setFileInfo("test file", 1, "test method").Exactly(2);
+		fakeit::VerifyNoOtherInvocations(mock).setFileInfo("test file", 1, "test method");
+	}
+
 	void ShouldThrow_UnexpectedMethodCallException_IfAdapterDidNotThrowException_WhenHandlingAnUnmatchedInvocation() {
 		setup();
 		finally onExit(teardown);
@@ -24,7 +24,8 @@ struct GccMultipleStubbing: tpunit::TestFixture {
 					TEST(GccMultipleStubbing::stub_multiple_throws_with_quantifier),
 					TEST(GccMultipleStubbing::stub_multiple_return_values_with_mixed_values_and_quantifiers),
 					TEST(GccMultipleStubbing::stub_multiple_return_values_with_quantifier),
-					TEST(GccMultipleStubbing::stub_multiple_throws_and_returns)
+					TEST(GccMultipleStubbing::stub_multiple_throws_and_returns),
+					TEST(GccMultipleStubbing::stubbed_return_values_are_copied)
 					//
 							) {
 	}
@@ -51,6 +52,22 @@ struct GccMultipleStubbing: tpunit::TestFixture {
 		ASSERT_THROW(i.proc(1), fakeit::UnexpectedMethodCallException);
 	}
 
+	void stubbed_return_values_are_copied() {
+		Mock<SomeInterface> mock;
+		int once = 1;
+		int always = 2;
+		When(Method(mock,func)).Return(once, 2_Times(once)).AlwaysReturn(always);
+		once = 0;
+		always = 0;
+
+		SomeInterface &i = mock.get();
+		ASSERT_EQUAL(1, i.func(1));
+		ASSERT_EQUAL(1, i.func(1));
+		ASSERT_EQUAL(1, i.func(1));
+		ASSERT_EQUAL(2, i.func(1));
+		ASSERT_EQUAL(2, i.func(1));
+	}
+
 	void stub_multiple_return_values_with_mixed_values_and_quantifiers() {
 		Mock<SomeInterface> mock;
 		When(Method(mock,func)).Return(0, 2_Times(1), 2);
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+namespace {
+    struct Point {
+        int x;
+        int y;
+
+        bool operator==(const Point &other) const {
+            return x == other.x && y == other.y;
+        }
+    };
+}
+
+namespace fakeit {
+    template<>
+    struct TraceCodec<Point> {
+        static void write(TraceOutput &out, const Point &value) {
+            TraceCodec<int>::write(out, value.x);
+            TraceCodec<int>::write(out, value.y);
+        }
+
+        static Point read(TraceInput &in) {
+            int x = TraceCodec<int>::read(in);
+            int y = TraceCodec<int>::read(in);
+            return Point{x, y};
+        }
+    };
+}
+
+struct InvocationTraceTests : tpunit::TestFixture {
+    InvocationTraceTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(InvocationTraceTests::replayed_invocations_can_be_verified),//
+                    TEST(InvocationTraceTests::replayed_invocations_keep_their_order),//
+                    TEST(InvocationTraceTests::replayed_invocations_follow_the_calls_made_before),//
+                    TEST(InvocationTraceTests::replayed_invocations_are_kept_to_the_history_limit),//
+                    TEST(InvocationTraceTests::traced_mock_can_not_be_verified),//
+                    TEST(InvocationTraceTests::unmatched_calls_are_not_traced),//
+                    TEST(InvocationTraceTests::only_the_given_methods_are_replayed),//
+                    TEST(InvocationTraceTests::user_defined_codec_is_used),//
+                    TEST(InvocationTraceTests::fingerprint_capture_is_traced_as_fingerprints),//
+                    TEST(InvocationTraceTests::reference_capture_is_traced_without_arguments),//
+                    TEST(InvocationTraceTests::replay_prefers_the_method_of_the_same_mock),//
+                    TEST(InvocationTraceTests::bad_traces_are_rejected)
+            ) {
+    }
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+
+        virtual void proc(const std::string &) = 0;
+
+        virtual void draw(Point) = 0;
+    };
+
+    void replayed_invocations_can_be_verified() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, func), Method(mock, proc));
+            SomeInterface &i = mock.get();
+            i.func(1);
+            i.func(2);
+            i.proc("text");
+            ASSERT_EQUAL(3ull, trace.getInvocationsCount());
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ASSERT_EQUAL(3, (int) ReplayTrace(reader, Method(mock, func), Method(mock, proc)));
+        Verify(Method(mock, func).Using(1)).Once();
+        Verify(Method(mock, func)).Twice();
+        Verify(Method(mock, proc).Using("text")).Once();
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void replayed_invocations_keep_their_order() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, func), Method(mock, proc));
+            SomeInterface &i = mock.get();
+            i.proc("first");
+            i.func(1);
+            i.proc("last");
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ReplayTrace(reader, Method(mock, func), Method(mock, proc));
+        Verify(Method(mock, proc).Using("first"), Method(mock, func), Method(mock, proc).Using("last"));
+        ASSERT_THROW(Verify(Method(mock, func), Method(mock, proc).Using("first")), fakeit::SequenceVerificationException);
+    }
+
+    static void traceFuncCalls(std::stringstream &file) {
+        InvocationTraceWriter trace(file);
+        Mock<SomeInterface> mock(TraceTo(trace));
+        Fake(Method(mock, func));
+        mock.get().func(1);
+        mock.get().func(2);
+        mock.get().func(3);
+    }
+
+    void replayed_invocations_follow_the_calls_made_before() {
+        std::stringstream file;
+        traceFuncCalls(file);
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        Fake(Method(mock, func));
+        mock.get().func(0);
+        ReplayTrace(reader, Method(mock, func));
+        mock.get().func(4);
+        Verify(Method(mock, func).Using(0), Method(mock, func).Using(1), Method(mock, func).Using(2),
+               Method(mock, func).Using(3), Method(mock, func).Using(4));
+    }
+
+    void replayed_invocations_are_kept_to_the_history_limit() {
+        std::stringstream file;
+        traceFuncCalls(file);
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock(KeepLast(2));
+        ASSERT_EQUAL(3, (int) ReplayTrace(reader, Method(mock, func)));
+        Verify(Method(mock, func).Using(2), Method(mock, func).Using(3));
+        Verify(Method(mock, func)).Exactly(3);
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void traced_mock_can_not_be_verified() {
+        std::stringstream file;
+        InvocationTraceWriter trace(file);
+        Mock<SomeInterface> mock(TraceTo(trace));
+        Fake(Method(mock, func));
+        mock.get().func(1);
+        ASSERT_THROW(Verify(Method(mock, func)), std::invalid_argument);
+    }
+
+    void unmatched_calls_are_not_traced() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            When(Method(mock, func).Using(1)).AlwaysReturn(1);
+            ASSERT_EQUAL(1, mock.get().func(1));
+            ASSERT_THROW(mock.get().func(2), fakeit::UnexpectedMethodCallException);
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ASSERT_EQUAL(1, (int) ReplayTrace(reader, Method(mock, func)));
+        Verify(Method(mock, func).Using(1)).Once();
+    }
+
+    void only_the_given_methods_are_replayed() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, func), Method(mock, proc));
+            mock.get().func(1);
+            mock.get().proc("skipped");
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ASSERT_EQUAL(1, (int) ReplayTrace(reader, Method(mock, func)));
+        Verify(Method(mock, func)).Once();
+        Verify(Method(mock, proc)).Never();
+    }
+
+    void user_defined_codec_is_used() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, draw));
+            mock.get().draw(Point{1, 2});
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ReplayTrace(reader, Method(mock, draw));
+        Verify(Method(mock, draw).Using(Point{1, 2})).Once();
+        Verify(Method(mock, draw).Using(Point{2, 1})).Never();
+    }
+
+    void fingerprint_capture_is_traced_as_fingerprints() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, proc).Capture(ArgumentsCapture::ByFingerprint));
+            mock.get().proc("text");
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ReplayTrace(reader, Method(mock, proc));
+        Verify(Method(mock, proc).Using("text")).Once();
+        Verify(Method(mock, proc).Using("other")).Never();
+        ASSERT_THROW(Verify(Method(mock, proc).Using(_)), std::invalid_argument);
+    }
+
+    void reference_capture_is_traced_without_arguments() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, func).Capture(ArgumentsCapture::ByReference));
+            mock.get().func(1);
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> mock;
+        ReplayTrace(reader, Method(mock, func));
+        Verify(Method(mock, func)).Once();
+        ASSERT_THROW(Verify(Method(mock, func).Using(1)), std::invalid_argument);
+    }
+
+    void replay_prefers_the_method_of_the_same_mock() {
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> first(TraceTo(trace));
+            Mock<SomeInterface> second(TraceTo(trace));
+            Fake(Method(first, func), Method(second, func));
+            first.get().func(1);
+            second.get().func(2);
+        }
+        InvocationTraceReader reader(file);
+        Mock<SomeInterface> first;
+        Mock<SomeInterface> second;
+        ReplayTrace(reader, Method(first, func), Method(second, func));
+        Verify(Method(first, func).Using(1)).Once();
+        Verify(Method(second, func).Using(2)).Once();
+        VerifyNoOtherInvocations(first, second);
+    }
+
+    void bad_traces_are_rejected() {
+        std::stringstream notATrace("not a trace");
+        ASSERT_THROW(InvocationTraceReader reader(notATrace), std::invalid_argument);
+
+        std::stringstream file;
+        {
+            InvocationTraceWriter trace(file);
+            Mock<SomeInterface> mock(TraceTo(trace));
+            Fake(Method(mock, func));
+            mock.get().func(1);
+        }
+        std::string bytes = file.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+        InvocationTraceReader reader(truncated);
+        Mock<SomeInterface> mock;
+        ASSERT_THROW(ReplayTrace(reader, Method(mock, func)), std::runtime_error);
+    }
+
+} __InvocationTraceTests;
@@ -7,7 +7,10 @@
  */
 
 #include <string>
+#include <atomic>
 #include <queue>
+#include <thread>
+#include <vector>
 
 #include "tpunit++.hpp"
 #include "fakeit.hpp"
@@ -26,7 +29,11 @@ struct Miscellaneous : tpunit::TestFixture
         TEST(Miscellaneous::testStubFuncWithRightValueParameter),
 			TEST(Miscellaneous::testStubProcWithRightValueParameter),
 			TEST(Miscellaneous::aaa),
-        TEST(Miscellaneous::can_stub_method_after_reset)
+        TEST(Miscellaneous::can_stub_method_after_reset), //
+        TEST(Miscellaneous::equal_interned_strings_share_one_copy), //
+        TEST(Miscellaneous::strings_are_interned_again_after_their_last_handle), //
+        TEST(Miscellaneous::mock_created_after_another_was_destroyed_starts_clean), //
+        TEST(Miscellaneous::mock_reset_repeatedly_starts_clean_each_time)
         )
     {
     }
@@ -309,4 +316,78 @@ struct Miscellaneous : tpunit::TestFixture
 //		Verify(Method(factory, Create)).Once();
 	}
 
+    void equal_interned_strings_share_one_copy()
+    {
+        InternedString a("mock");
+        InternedString b(std::string("mo") + "ck");
+        ASSERT_TRUE(a == b);
+        ASSERT_EQUAL(&a.str(), &b.str());
+        ASSERT_TRUE(a != InternedString("other"));
+        ASSERT_TRUE(InternedString().empty());
+    }
+
+    void strings_are_interned_again_after_their_last_handle()
+    {
+        std::atomic<int> mismatches{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&mismatches]() {
+                for (int n = 0; n < 1000; n++) {
+                    InternedString a("short lived");
+                    InternedString b(a);
+                    b = InternedString(std::string("short ") + "lived");
+                    if (a != b || a.str() != "short lived")
+                        mismatches++;
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        ASSERT_EQUAL(0, mismatches.load());
+        ASSERT_EQUAL(std::string("short lived"), InternedString("short lived").str());
+    }
+
+    struct Recycled {
+        virtual int func(int) = 0;
+        virtual int other(int) = 0;
+    };
+
+    void mock_created_after_another_was_destroyed_starts_clean()
+    {
+        {
+            Mock<Recycled> mock;
+            When(Method(mock, func)).AlwaysReturn(1);
+            When(Method(mock, other)).AlwaysReturn(2);
+            ASSERT_EQUAL(1, mock.get().func(0));
+        }
+        // reuses the tables of the destroyed mock
+        Mock<Recycled> mock;
+        ASSERT_THROW(mock.get().func(0), fakeit::UnexpectedMethodCallException);
+        When(Method(mock, other)).AlwaysReturn(3);
+        ASSERT_EQUAL(3, mock.get().other(0));
+        Verify(Method(mock, other)).Once();
+        VerifyNoOtherInvocations(Method(mock, other));
+    }
+
+    void mock_reset_repeatedly_starts_clean_each_time()
+    {
+        Mock<foo_bar> mock;
+        foo_bar &i = mock.get();
+        for (int round = 0; round < 3; round++) {
+            // the method bodies of the previous round are reused
+            When(Method(mock, foo)).Return(round);
+            When(Method(mock, foo)).Return(round + 1);
+            Fake(Dtor(mock));
+            ASSERT_EQUAL(round + 1, i.foo());
+            ASSERT_THROW(i.bar(), fakeit::UnexpectedMethodCallException);
+            Verify(Method(mock, foo)).Once();
+            VerifyNoOtherInvocations(mock);
+            mock.Reset();
+            ASSERT_THROW(i.foo(), fakeit::UnexpectedMethodCallException);
+            Verify(Method(mock, foo)).Never();
+            VerifyNoOtherInvocations(mock);
+        }
+    }
+
 } __Miscellaneous;
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <stdexcept>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct NoRecordingTests : tpunit::TestFixture {
+    NoRecordingTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(NoRecordingTests::stubbed_methods_are_dispatched),//
+                    TEST(NoRecordingTests::unmatched_call_should_raise_UnexpectedMethodCallException),//
+                    TEST(NoRecordingTests::stub_after_reset),//
+                    TEST(NoRecordingTests::spy_without_recording),//
+                    TEST(NoRecordingTests::verify_should_throw_invalid_argument),//
+                    TEST(NoRecordingTests::verify_no_other_invocations_should_throw_invalid_argument),//
+                    TEST(NoRecordingTests::verify_other_mocks_in_same_test)
+            ) {
+    }
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+
+        virtual void proc(int) = 0;
+    };
+
+    void stubbed_methods_are_dispatched() {
+        Mock<SomeInterface> mock(NoRecording);
+        When(Method(mock, func).Using(1)).Return(1, 2);
+        When(Method(mock, func).Using(2)).AlwaysReturn(3);
+        int sum = 0;
+        When(Method(mock, proc)).AlwaysDo([&](int a) { sum += a; });
+        SomeInterface &i = mock.get();
+        ASSERT_EQUAL(1, i.func(1));
+        ASSERT_EQUAL(2, i.func(1));
+        ASSERT_EQUAL(3, i.func(2));
+        ASSERT_EQUAL(3, i.func(2));
+        i.proc(1);
+        i.proc(2);
+        ASSERT_EQUAL(3, sum);
+    }
+
+    void unmatched_call_should_raise_UnexpectedMethodCallException() {
+        Mock<SomeInterface> mock(NoRecording);
+        When(Method(mock, func).Using(1)).Return(1);
+        SomeInterface &i = mock.get();
+        ASSERT_THROW(i.func(2), fakeit::UnexpectedMethodCallException);
+        ASSERT_EQUAL(1, i.func(1));
+        ASSERT_THROW(i.func(1), fakeit::UnexpectedMethodCallException);
+    }
+
+    void stub_after_reset() {
+        Mock<SomeInterface> mock(NoRecording);
+        When(Method(mock, func)).AlwaysReturn(1);
+        mock.Reset();
+        When(Method(mock, func)).AlwaysReturn(2);
+        ASSERT_EQUAL(2, mock.get().func(1));
+        ASSERT_THROW(Verify(Method(mock, func)), std::invalid_argument);
+    }
+
+    struct SomeClass {
+        virtual int func(int a) {
+            return a;
+        }
+    };
+
+    void spy_without_recording() {
+        SomeClass obj;
+        Mock<SomeClass> spy(obj, NoRecording);
+        Spy(Method(spy, func));
+        ASSERT_EQUAL(5, spy.get().func(5));
+        ASSERT_THROW(Verify(Method(spy, func)), std::invalid_argument);
+    }
+
+    void verify_should_throw_invalid_argument() {
+        Mock<SomeInterface> mock(NoRecording);
+        Fake(Method(mock, func));
+        mock.get().func(1);
+        ASSERT_THROW(Verify(Method(mock, func)), std::invalid_argument);
+        ASSERT_THROW(Verify(Method(mock, func)).Never(), std::invalid_argument);
+        ASSERT_THROW(Verify(Method(mock, func).Using(1)).Once(), std::invalid_argument);
+    }
+
+    void verify_no_other_invocations_should_throw_invalid_argument() {
+        Mock<SomeInterface> mock(NoRecording);
+        Fake(Method(mock, proc));
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), std::invalid_argument);
+        ASSERT_THROW(VerifyNoOtherInvocations(Method(mock, proc)), std::invalid_argument);
+    }
+
+    void verify_other_mocks_in_same_test() {
+        Mock<SomeInterface> fake(NoRecording);
+        Mock<SomeInterface> mock;
+        Fake(Method(fake, func), Method(mock, func));
+        fake.get().func(1);
+        mock.get().func(1);
+        Verify(Method(mock, func)).Once();
+        VerifyNoOtherInvocations(mock);
+    }
+
+} __NoRecordingTests;
@@ -24,7 +24,9 @@ struct SequenceVerification: tpunit::TestFixture {
 					TEST(SequenceVerification::verify_multi_sequences_in_order), //
 					TEST(SequenceVerification::use_only_mocks_that_are_involved_in_verifed_sequence_for_verification), //
 					TEST(SequenceVerification::use_only_filters_that_are_involved_in_verifed_sequence_for_verification), //
-					TEST(SequenceVerification::should_throw_argument_exception_on_invalid_repetiotions_number)) //
+					TEST(SequenceVerification::should_throw_argument_exception_on_invalid_repetiotions_number), //
+					TEST(SequenceVerification::verify_long_sequence_after_partial_matches), //
+					TEST(SequenceVerification::verify_with_invocation_sources_listed_more_than_once)) //
 	{
 	}
 
@@ -230,4 +232,44 @@ struct SequenceVerification: tpunit::TestFixture {
 		ASSERT_THROW(Using(Method(mock1,func).Using(1)).Verify(Method(mock1,func) * 2), fakeit::VerificationException);
 	}
 
+	void verify_long_sequence_after_partial_matches() {
+		Mock<SomeInterface> mock;
+		Fake(Method(mock,func), Method(mock,proc));
+		SomeInterface &i = mock.get();
+
+		for (int n = 0; n < 100; n++)
+			i.func(1);
+		i.proc(1);
+		for (int n = 0; n < 70; n++)
+			i.func(2);
+		i.proc(2);
+
+		Verify(Method(mock,func) * 70 + Method(mock,proc)).Twice();
+		Verify(Method(mock,func).Using(1) * 100 + Method(mock,proc).Using(1)).Once();
+		Verify(Method(mock,func).Using(2) * 70 + Method(mock,proc)).Once();
+		Verify(Method(mock,func).Using(1) * 2, Method(mock,func).Using(2) * 65, Method(mock,proc).Using(2)).Once();
+		ASSERT_THROW(Verify(Method(mock,func).Using(2) * 71 + Method(mock,proc)), fakeit::VerificationException);
+		ASSERT_THROW(Verify(Method(mock,func) * 130), fakeit::VerificationException);
+	}
+
+	void verify_with_invocation_sources_listed_more_than_once() {
+		Mock<SomeInterface> mock1;
+		Mock<SomeInterface> mock2;
+		Fake(Method(mock1,func), Method(mock1,proc), Method(mock2,func));
+
+		mock1.get().func(1);
+		mock2.get().func(2);
+		mock1.get().proc(3);
+		mock2.get().func(4);
+
+		Using(mock1, mock2, Method(mock1,func)).Verify(
+				Method(mock1,func) + Method(mock2,func) + Method(mock1,proc) + Method(mock2,func)).Once();
+		ASSERT_THROW(Using(mock1, mock1).Verify(Method(mock1,func) * 2), fakeit::VerificationException);
+		ASSERT_THROW(Using(mock2, Method(mock2,func)).Verify(Method(mock2,func).Using(2) * 2), fakeit::VerificationException);
+		Verify(Method(mock1,func) + Method(mock1,proc)).Once();
+		VerifyNoOtherInvocations(mock1, Method(mock1,func), mock1);
+		mock2.get().func(5);
+		ASSERT_THROW(VerifyNoOtherInvocations(mock1, mock2), fakeit::VerificationException);
+	}
+
 } __SequenceVerification;
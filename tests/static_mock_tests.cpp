@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <stdexcept>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+namespace static_mock_tests {
+
+    struct SomeInterface {
+        virtual ~SomeInterface() = default;
+
+        virtual int func(int) = 0;
+
+        virtual int print(int) = 0;
+
+        virtual int print(int, const std::string &) = 0;
+
+        virtual void proc(std::string &) = 0;
+
+        virtual std::string name() const = 0;
+
+        virtual int notDeclared() {
+            return 0;
+        }
+    };
+
+    FAKEIT_STATIC_MOCK(SomeMock, SomeInterface,
+        FAKEIT_STATIC_METHOD1(func, int(int))
+        FAKEIT_STATIC_METHOD1(print, int(int))
+        FAKEIT_STATIC_METHOD2(print, int(int, const std::string &))
+        FAKEIT_STATIC_METHOD1(proc, void(std::string &))
+        FAKEIT_STATIC_CONST_METHOD0(name, std::string())
+    );
+}
+
+using namespace static_mock_tests;
+
+struct StaticMockTests : tpunit::TestFixture {
+    StaticMockTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(StaticMockTests::stub_and_verify_a_method),//
+                    TEST(StaticMockTests::overloads_and_const_methods),//
+                    TEST(StaticMockTests::arguments_are_passed_by_reference),//
+                    TEST(StaticMockTests::unmatched_call_throws),//
+                    TEST(StaticMockTests::verify_no_other_invocations),//
+                    TEST(StaticMockTests::reset_forgets_stubbing_and_invocations),//
+                    TEST(StaticMockTests::undeclared_method_cannot_be_stubbed),//
+                    TEST(StaticMockTests::delete_through_the_interface_is_a_call_of_the_destructor),//
+                    TEST(StaticMockTests::stubbed_destructor_runs_its_action)
+            ) {
+    }
+
+    void stub_and_verify_a_method() {
+        SomeMock mock;
+        When(Method(mock, func).Using(1)).Return(10);
+        When(Method(mock, func).Using(2)).AlwaysReturn(20);
+        SomeInterface &i = mock.get();
+        ASSERT_EQUAL(10, i.func(1));
+        ASSERT_EQUAL(20, i.func(2));
+        ASSERT_EQUAL(20, i.func(2));
+        Verify(Method(mock, func).Using(2)).Exactly(2);
+        Verify(Method(mock, func).Using(1) + Method(mock, func).Using(2));
+        ASSERT_THROW(Verify(Method(mock, func).Using(3)), fakeit::SequenceVerificationException);
+    }
+
+    void overloads_and_const_methods() {
+        SomeMock mock;
+        When(OverloadedMethod(mock, print, int(int))).AlwaysReturn(1);
+        When(OverloadedMethod(mock, print, int(int, const std::string &))).AlwaysReturn(2);
+        When(Method(mock, name)).AlwaysReturn("some name");
+        const SomeInterface &c = mock.get();
+        ASSERT_EQUAL(std::string("some name"), c.name());
+        std::string a = "a";
+        ASSERT_EQUAL(1, mock().print(0));
+        ASSERT_EQUAL(2, mock().print(0, a));
+        Verify(OverloadedMethod(mock, print, int(int, const std::string &)).Using(0, "a")).Once();
+        Verify(Method(mock, name)).Once();
+    }
+
+    void arguments_are_passed_by_reference() {
+        SomeMock mock;
+        When(Method(mock, proc)).AlwaysDo([](std::string &s) { s = "changed"; });
+        std::string s = "original";
+        mock.get().proc(s);
+        ASSERT_EQUAL(std::string("changed"), s);
+    }
+
+    void unmatched_call_throws() {
+        SomeMock mock;
+        When(Method(mock, func).Using(1)).Return(1);
+        try {
+            mock.get().func(2);
+            FAIL();
+        } catch (fakeit::UnexpectedMethodCallException &e) {
+            ASSERT_TRUE(e.what().find("mock.func(2)") != std::string::npos);
+        }
+        ASSERT_THROW(mock.get().name(), fakeit::UnexpectedMethodCallException);
+    }
+
+    void verify_no_other_invocations() {
+        SomeMock mock;
+        Fake(Method(mock, proc), Method(mock, name));
+        std::string s;
+        mock.get().proc(s);
+        mock.get().name();
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::NoMoreInvocationsVerificationException);
+        Verify(Method(mock, proc));
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::NoMoreInvocationsVerificationException);
+        Verify(Method(mock, name));
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void reset_forgets_stubbing_and_invocations() {
+        SomeMock mock;
+        When(Method(mock, name)).AlwaysReturn("before");
+        ASSERT_EQUAL(std::string("before"), mock.get().name());
+        mock.Reset();
+        VerifyNoOtherInvocations(mock);
+        ASSERT_THROW(mock.get().name(), fakeit::UnexpectedMethodCallException);
+        When(Method(mock, name)).AlwaysReturn("after");
+        ASSERT_EQUAL(std::string("after"), mock.get().name());
+    }
+
+    void undeclared_method_cannot_be_stubbed() {
+        SomeMock mock;
+        ASSERT_THROW(Method(mock, notDeclared), std::invalid_argument);
+        ASSERT_EQUAL(0, mock.get().notDeclared());
+    }
+
+    void delete_through_the_interface_is_a_call_of_the_destructor() {
+        SomeMock mock;
+        Fake(Method(mock, func));
+        SomeInterface *i = &mock.get();
+        i->func(1);
+        delete i;
+        Verify(Dtor(mock)).Once();
+        Verify(Method(mock, func).Using(1)).Once();
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void stubbed_destructor_runs_its_action() {
+        SomeMock mock;
+        int destroyed = 0;
+        When(Dtor(mock)).Do([&]() { destroyed++; });
+        delete &mock.get();
+        ASSERT_EQUAL(1, destroyed);
+        Verify(Dtor(mock)).Once();
+        mock.Reset();
+        VerifyNoOtherInvocations(mock);
+    }
+
+} __StaticMockTests;
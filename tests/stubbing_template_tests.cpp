@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct StubbingTemplateTests : tpunit::TestFixture {
+    StubbingTemplateTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(StubbingTemplateTests::mock_is_stubbed_like_its_template),//
+                    TEST(StubbingTemplateTests::invocations_are_recorded_per_mock),//
+                    TEST(StubbingTemplateTests::stubbing_a_mock_does_not_change_the_others),//
+                    TEST(StubbingTemplateTests::reset_only_resets_one_mock),//
+                    TEST(StubbingTemplateTests::template_can_be_destroyed_first),//
+                    TEST(StubbingTemplateTests::dtor_stubbing_is_shared),//
+                    TEST(StubbingTemplateTests::template_can_be_a_spy),//
+                    TEST(StubbingTemplateTests::each_mock_goes_through_a_sequence_on_its_own),//
+                    TEST(StubbingTemplateTests::mock_is_named_by_its_own_methods)
+            ) {
+    }
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+
+        virtual void proc(int) = 0;
+
+        virtual int other(int) = 0;
+    };
+
+    struct WithDtor {
+        virtual ~WithDtor() = default;
+
+        virtual int func() = 0;
+    };
+
+    struct Real : public SomeInterface {
+        int func(int i) override {
+            return i;
+        }
+
+        void proc(int) override {
+        }
+
+        int other(int i) override {
+            return i;
+        }
+    };
+
+    void mock_is_stubbed_like_its_template() {
+        Mock<SomeInterface> prototype;
+        When(Method(prototype, func).Using(1)).AlwaysReturn(10);
+        When(Method(prototype, func).Using(2)).AlwaysReturn(20);
+        Fake(Method(prototype, proc));
+
+        Mock<SomeInterface> mock(StubbedLike(prototype));
+        SomeInterface &i = mock.get();
+        ASSERT_EQUAL(10, i.func(1));
+        ASSERT_EQUAL(20, i.func(2));
+        i.proc(1);
+        ASSERT_THROW(i.func(3), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(i.other(1), fakeit::UnexpectedMethodCallException);
+    }
+
+    void invocations_are_recorded_per_mock() {
+        Mock<SomeInterface> prototype;
+        Fake(Method(prototype, func), Method(prototype, proc));
+        Mock<SomeInterface> a(StubbedLike(prototype));
+        Mock<SomeInterface> b(StubbedLike(prototype));
+        a.get().func(1);
+        b.get().proc(2);
+        b.get().proc(3);
+        Verify(Method(a, func).Using(1)).Once();
+        Verify(Method(b, proc)).Twice();
+        Verify(Method(a, proc)).Never();
+        Verify(Method(prototype, func)).Never();
+        VerifyNoOtherInvocations(a);
+        VerifyNoOtherInvocations(b);
+    }
+
+    void stubbing_a_mock_does_not_change_the_others() {
+        Mock<SomeInterface> prototype;
+        When(Method(prototype, func)).AlwaysReturn(1);
+        Mock<SomeInterface> a(StubbedLike(prototype));
+        Mock<SomeInterface> b(StubbedLike(prototype));
+        When(Method(a, func).Using(5)).AlwaysReturn(5);
+        When(Method(a, other)).AlwaysReturn(3);
+        When(Method(prototype, func)).AlwaysReturn(2);
+        ASSERT_EQUAL(5, a.get().func(5));
+        ASSERT_EQUAL(1, a.get().func(6));
+        ASSERT_EQUAL(3, a.get().other(1));
+        ASSERT_EQUAL(1, b.get().func(5));
+        ASSERT_THROW(b.get().other(1), fakeit::UnexpectedMethodCallException);
+        ASSERT_EQUAL(2, prototype.get().func(5));
+    }
+
+    void reset_only_resets_one_mock() {
+        Mock<SomeInterface> prototype;
+        When(Method(prototype, func)).AlwaysReturn(1);
+        Mock<SomeInterface> a(StubbedLike(prototype));
+        Mock<SomeInterface> b(StubbedLike(prototype));
+        a.Reset();
+        prototype.Reset();
+        ASSERT_THROW(a.get().func(1), fakeit::UnexpectedMethodCallException);
+        ASSERT_THROW(prototype.get().func(1), fakeit::UnexpectedMethodCallException);
+        ASSERT_EQUAL(1, b.get().func(1));
+        When(Method(a, func)).AlwaysReturn(3);
+        ASSERT_EQUAL(3, a.get().func(1));
+    }
+
+    void template_can_be_destroyed_first() {
+        Mock<SomeInterface> &prototype = *new Mock<SomeInterface>();
+        When(Method(prototype, func)).AlwaysReturn(1);
+        Mock<SomeInterface> mock(StubbedLike(prototype));
+        delete &prototype;
+        ASSERT_EQUAL(1, mock.get().func(1));
+        Verify(Method(mock, func)).Once();
+    }
+
+    void dtor_stubbing_is_shared() {
+        Mock<WithDtor> prototype;
+        Fake(Dtor(prototype));
+        When(Method(prototype, func)).AlwaysReturn(1);
+        Mock<WithDtor> mock(StubbedLike(prototype));
+        WithDtor *i = &mock.get();
+        ASSERT_EQUAL(1, i->func());
+        delete i;
+        Verify(Dtor(mock)).Once();
+        Verify(Dtor(prototype)).Never();
+    }
+
+    void template_can_be_a_spy() {
+        Real real;
+        Mock<SomeInterface> spy(real);
+        When(Method(spy, func)).AlwaysReturn(7);
+        Mock<SomeInterface> mock(StubbedLike(spy));
+        ASSERT_EQUAL(7, mock.get().func(1));
+        // the template's unstubbed methods are the real ones, they are not taken.
+        ASSERT_THROW(mock.get().other(1), fakeit::UnexpectedMethodCallException);
+    }
+
+    void each_mock_goes_through_a_sequence_on_its_own() {
+        Mock<SomeInterface> prototype;
+        When(Method(prototype, func)).Return(1, 2);
+        When(Method(prototype, other)).Return(3).AlwaysReturn(4);
+        Mock<SomeInterface> a(StubbedLike(prototype));
+        Mock<SomeInterface> b(StubbedLike(prototype));
+        ASSERT_EQUAL(1, a.get().func(0));
+        ASSERT_EQUAL(1, b.get().func(0));
+        ASSERT_EQUAL(2, a.get().func(0));
+        ASSERT_THROW(a.get().func(0), fakeit::UnexpectedMethodCallException);
+        ASSERT_EQUAL(2, b.get().func(0));
+        ASSERT_EQUAL(1, prototype.get().func(0));
+        ASSERT_EQUAL(3, a.get().other(0));
+        ASSERT_EQUAL(4, a.get().other(0));
+        ASSERT_EQUAL(3, b.get().other(0));
+        a.Reset();
+        ASSERT_THROW(a.get().func(0), fakeit::UnexpectedMethodCallException);
+        ASSERT_EQUAL(3, prototype.get().other(0));
+    }
+
+    void mock_is_named_by_its_own_methods() {
+        Mock<SomeInterface> prototype;
+        When(Method(prototype, func).Using(1)).AlwaysReturn(1);
+        Mock<SomeInterface> mock(StubbedLike(prototype));
+        try {
+            mock.get().func(2);
+            FAIL();
+        } catch (fakeit::UnexpectedMethodCallException &e) {
+            ASSERT_TRUE(e.what().find("func(2)") != std::string::npos);
+            ASSERT_TRUE(e.what().find("prototype") == std::string::npos);
+        }
+        mock.get().func(1);
+        try {
+            Verify(Method(mock, func).Using(1)).Twice();
+            FAIL();
+        } catch (fakeit::SequenceVerificationException &e) {
+            ASSERT_TRUE(std::string(e.what()).find("mock.func(1)") != std::string::npos);
+            ASSERT_TRUE(std::string(e.what()).find("prototype") == std::string::npos);
+        }
+    }
+
+} __StubbingTemplateTests;
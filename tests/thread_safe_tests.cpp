@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2014 Eran Pe'er.
+ *
+ * This program is made available under the terms of the MIT License.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+#include "tpunit++.hpp"
+#include "fakeit.hpp"
+
+using namespace fakeit;
+
+struct ThreadSafeTests : tpunit::TestFixture {
+    ThreadSafeTests() :
+            tpunit::TestFixture(
+                    //
+                    TEST(ThreadSafeTests::concurrent_calls_are_all_recorded),//
+                    TEST(ThreadSafeTests::finite_actions_are_invoked_exactly_as_stubbed),//
+                    TEST(ThreadSafeTests::each_scripted_value_is_returned_once),//
+                    TEST(ThreadSafeTests::invocations_of_all_threads_are_verified_in_order),//
+                    TEST(ThreadSafeTests::verify_no_other_invocations_after_concurrent_calls),//
+                    TEST(ThreadSafeTests::unmatched_concurrent_calls_are_not_recorded),//
+                    TEST(ThreadSafeTests::reset_after_concurrent_calls)
+            ) {
+    }
+
+    static const int THREADS = 32;
+    static const int CALLS_PER_THREAD = 1000;
+
+    struct SomeInterface {
+        virtual int func(int) = 0;
+
+        virtual void proc(int) = 0;
+    };
+
+    static void runOnThreads(std::function<void(int)> body) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back(body, t);
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    void concurrent_calls_are_all_recorded() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        When(Method(mock, func)).AlwaysReturn(1);
+        Fake(Method(mock, proc));
+        SomeInterface &i = mock.get();
+        runOnThreads([&](int t) {
+            for (int call = 0; call < CALLS_PER_THREAD; call++) {
+                i.func(t);
+                i.proc(t);
+            }
+        });
+        Verify(Method(mock, func)).Exactly(THREADS * CALLS_PER_THREAD);
+        Verify(Method(mock, proc)).Exactly(THREADS * CALLS_PER_THREAD);
+        for (int t = 0; t < THREADS; t++) {
+            Verify(Method(mock, func).Using(t)).Exactly(CALLS_PER_THREAD);
+        }
+    }
+
+    void finite_actions_are_invoked_exactly_as_stubbed() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        When(Method(mock, func)).Return(7000_Times(1)).AlwaysReturn(0);
+        SomeInterface &i = mock.get();
+        std::atomic<int> sum{0};
+        runOnThreads([&](int t) {
+            for (int call = 0; call < CALLS_PER_THREAD; call++) {
+                sum += i.func(t);
+            }
+        });
+        ASSERT_EQUAL(7000, sum.load());
+    }
+
+    void each_scripted_value_is_returned_once() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        When(Method(mock, func)).Return(1, 2, 3, 4, 5, 6, 7, 8).Return(1000_Times(9)).Throw(10).AlwaysReturn(0);
+        SomeInterface &i = mock.get();
+        std::atomic<int> returned[11];
+        for (std::atomic<int> &count : returned) {
+            count = 0;
+        }
+        runOnThreads([&](int t) {
+            for (int call = 0; call < CALLS_PER_THREAD; call++) {
+                try {
+                    returned[i.func(t)]++;
+                } catch (int e) {
+                    returned[e]++;
+                }
+            }
+        });
+        for (int value = 1; value <= 8; value++) {
+            ASSERT_EQUAL(1, returned[value].load());
+        }
+        ASSERT_EQUAL(1000, returned[9].load());
+        ASSERT_EQUAL(1, returned[10].load());
+        ASSERT_EQUAL(THREADS * CALLS_PER_THREAD - 1009, returned[0].load());
+    }
+
+    void invocations_of_all_threads_are_verified_in_order() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        Fake(Method(mock, func), Method(mock, proc));
+        SomeInterface &i = mock.get();
+        i.proc(-1);
+        runOnThreads([&](int t) {
+            for (int call = 0; call < CALLS_PER_THREAD; call++) {
+                i.func(t);
+            }
+        });
+        i.proc(-2);
+        Verify(Method(mock, proc).Using(-1) + Method(mock, func) * (THREADS * CALLS_PER_THREAD) +
+               Method(mock, proc).Using(-2)).Once();
+        Verify(Method(mock, proc).Using(-2), Method(mock, proc).Using(-1)).Never();
+    }
+
+    void verify_no_other_invocations_after_concurrent_calls() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        Fake(Method(mock, func), Method(mock, proc));
+        SomeInterface &i = mock.get();
+        runOnThreads([&](int t) {
+            for (int call = 0; call < CALLS_PER_THREAD; call++) {
+                i.func(t);
+            }
+            i.proc(t);
+        });
+        Verify(Method(mock, func)).Exactly(THREADS * CALLS_PER_THREAD);
+        ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::VerificationException);
+        Verify(Method(mock, proc)).Exactly(THREADS);
+        VerifyNoOtherInvocations(mock);
+    }
+
+    void unmatched_concurrent_calls_are_not_recorded() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        When(Method(mock, func).Using(0)).AlwaysReturn(0);
+        SomeInterface &i = mock.get();
+        std::atomic<int> unexpected{0};
+        runOnThreads([&](int) {
+            for (int call = 0; call < CALLS_PER_THREAD; call++) {
+                try {
+                    i.func(call % 2);
+                } catch (UnexpectedMethodCallException &) {
+                    unexpected++;
+                }
+            }
+        });
+        ASSERT_EQUAL(THREADS * CALLS_PER_THREAD / 2, unexpected.load());
+        Verify(Method(mock, func)).Exactly(THREADS * CALLS_PER_THREAD / 2);
+        Verify(Method(mock, func).Using(1)).Never();
+    }
+
+    void reset_after_concurrent_calls() {
+        Mock<SomeInterface> mock(ThreadSafe);
+        Fake(Method(mock, func));
+        runOnThreads([&](int t) {
+            mock.get().func(t);
+        });
+        mock.Reset();
+        When(Method(mock, func)).AlwaysReturn(2);
+        std::atomic<int> sum{0};
+        runOnThreads([&](int t) {
+            sum += mock.get().func(t);
+        });
+        ASSERT_EQUAL(2 * THREADS, sum.load());
+        Verify(Method(mock, func)).Exactly(THREADS);
+    }
+
+} __ThreadSafeTests;
@@ -40,6 +40,7 @@ struct BasicVerification: tpunit::TestFixture {
 			tpunit::TestFixture(
 			//
                     TEST(BasicVerification::verificationProgressShouldBeConvertibleToBool), //
+                    TEST(BasicVerification::checkShouldTellWhetherVerificationPassedWithoutThrowing), //
 					TEST(BasicVerification::verifyWithUnverifiedFunctor), //
 					TEST(BasicVerification::verifyWithUnverifiedFunctorWithUsing), //
 					TEST(BasicVerification::verify_with_matcher), //
@@ -62,7 +63,9 @@ struct BasicVerification: tpunit::TestFixture {
 					TEST(BasicVerification::use_same_filter_for_both_stubbing_and_verification), //
 					TEST(BasicVerification::verify_after_paramter_was_changed__with_Matching), //
 					TEST(BasicVerification::verify_after_paramter_was_changed_with_argument_matcher), //
-					TEST(BasicVerification::verify_after_paramter_was_changed_with_Using)) //
+					TEST(BasicVerification::verify_after_paramter_was_changed_with_Using), //
+					TEST(BasicVerification::verify_many_invocations_and_reset), //
+					TEST(BasicVerification::verify_no_other_invocations_after_each_verification)) //
 	{
 	}
 
@@ -458,6 +461,32 @@ struct BasicVerification: tpunit::TestFixture {
 		Verify(2 * call_to_proc2_with_state_1);
 	}
 
+	void checkShouldTellWhetherVerificationPassedWithoutThrowing() {
+
+		struct AnInterface {
+			virtual int func(int) = 0;
+		};
+
+		Mock<AnInterface> mock;
+		When(Method(mock, func)).AlwaysReturn(0);
+
+		AnInterface &obj = mock.get();
+		obj.func(1);
+
+		ASSERT_FALSE(VerifyNoOtherInvocations(Method(mock, func)).Check());
+		ASSERT_TRUE(Verify(Method(mock, func)).Check());
+		ASSERT_FALSE(Verify(Method(mock, func).Using(2)).Check());
+		ASSERT_TRUE(Verify(Method(mock, func).Using(1)).Once().Check());
+		ASSERT_FALSE(Verify(Method(mock, func).Using(1)).Twice().Check());
+		ASSERT_TRUE(VerifyNoOtherInvocations(Method(mock, func)).Check());
+
+		// a verification runs once; checking it again gives the same answer
+		auto call = Method(mock, func);
+		auto twice = Verify(call).Twice();
+		ASSERT_FALSE(twice.Check());
+		ASSERT_FALSE(twice);
+	}
+
 	void verify_after_paramter_was_changed_with_argument_matcher() {
 		Mock<SomeInterface> mock;
 		A a1;
@@ -558,4 +587,42 @@ struct BasicVerification: tpunit::TestFixture {
 		ASSERT_FALSE(!VerifyNoOtherInvocations(Method(mock, func)));
     }
 
+	void verify_many_invocations_and_reset() {
+		Mock<SomeInterface> mock;
+		When(Method(mock, func).Using(Lt(3000))).AlwaysReturn(1);
+		SomeInterface &i = mock.get();
+		for (int n = 0; n < 3000; n++) {
+			i.func(n);
+		}
+		ASSERT_THROW(i.func(3000), fakeit::UnexpectedMethodCallException);
+		Verify(Method(mock, func)).Exactly(3000);
+		Verify(Method(mock, func).Using(0), Method(mock, func).Using(1500), Method(mock, func).Using(2999));
+		mock.Reset();
+		Fake(Method(mock, func));
+		i.func(1);
+		Verify(Method(mock, func)).Once();
+	}
+
+	void verify_no_other_invocations_after_each_verification() {
+		Mock<SomeInterface> mock;
+		When(Method(mock, func).Using(1)).AlwaysReturn(1);
+		Fake(Method(mock, proc));
+		SomeInterface &i = mock.get();
+		VerifyNoOtherInvocations(mock);
+		i.func(1);
+		ASSERT_THROW(i.func(2), fakeit::UnexpectedMethodCallException);
+		ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::VerificationException);
+		Verify(Method(mock, func)).Once();
+		Verify(Method(mock, func)).Once();
+		VerifyNoOtherInvocations(mock);
+		i.proc(1);
+		ASSERT_THROW(VerifyNoOtherInvocations(mock), fakeit::VerificationException);
+		VerifyNoOtherInvocations(Method(mock, func));
+		Verify(Method(mock, proc)).Once();
+		VerifyNoOtherInvocations(mock);
+		i.proc(2);
+		mock.Reset();
+		VerifyNoOtherInvocations(mock);
+	}
+
 } __BasicVerification;